@@ -0,0 +1,52 @@
+#include "Logic/concurrent_disjoint_set.h"
+
+#include <utility>
+
+ConcurrentDisjointSet::ConcurrentDisjointSet(int size)
+    : parent_(new std::atomic<int>[size > 0 ? size : 0])
+{
+    for (int index = 0; index < size; ++index) {
+        parent_[index].store(index, std::memory_order_relaxed);
+    }
+}
+
+int ConcurrentDisjointSet::find(int node)
+{
+    while (true) {
+        int parent = parent_[node].load(std::memory_order_acquire);
+        if (parent == node) {
+            return node;
+        }
+
+        const int grandparent = parent_[parent].load(std::memory_order_acquire);
+        if (grandparent == parent) {
+            return parent;
+        }
+        // Path splitting: point node at its grandparent, then continue from the old parent so every node on the
+        // path gets shortened. Losing the race is harmless, another thread only made the link shorter.
+        parent_[node].compare_exchange_weak(parent, grandparent, std::memory_order_acq_rel, std::memory_order_relaxed);
+        node = parent;
+    }
+}
+
+bool ConcurrentDisjointSet::unite(int first, int second)
+{
+    while (true) {
+        first = find(first);
+        second = find(second);
+        if (first == second) {
+            return false;
+        }
+
+        // Always hang the smaller index under the larger one so concurrent links can never form a loop.
+        if (first > second) {
+            std::swap(first, second);
+        }
+
+        int expected = first;
+        if (parent_[first].compare_exchange_strong(expected, second, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            return true;
+        }
+        // first stopped being a root while we looked; retry from the new roots
+    }
+}
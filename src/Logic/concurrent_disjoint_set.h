@@ -0,0 +1,17 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+// ConcurrentDisjointSet is a lock-free union-find that several threads may update at the same time.
+// Parent links are atomics: find() splits paths with best-effort CAS, unite() links roots with CAS.
+class ConcurrentDisjointSet {
+public:
+    explicit ConcurrentDisjointSet(int size);  // every node starts as its own root
+
+    int find(int node);  // representative of node's set, splitting the path while walking it
+    bool unite(int first, int second);  // merge two sets; false when they were already the same set
+
+private:
+    std::unique_ptr<std::atomic<int>[]> parent_;  // parent links, a root points at itself
+};
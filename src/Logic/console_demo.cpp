@@ -39,5 +39,26 @@ int main_example() {
     std::string directedAcyclicMessage = hasDirectedAcyclicCycle ? "directed acyclic graph reported a cycle" : "directed acyclic graph confirmed";
     std::cout << "Graph 4: " << directedAcyclicMessage << '\n';
 
+    Graph frozenCyclic(4, true);
+    frozenCyclic.addEdge(0, 1);
+    frozenCyclic.addEdge(1, 2);
+    frozenCyclic.addEdge(2, 3);
+    frozenCyclic.addEdge(3, 1);
+    frozenCyclic.freeze();
+
+    bool hasFrozenCycle = frozenCyclic.detectCycle();
+    std::string frozenMessage = hasFrozenCycle ? "frozen (CSR) directed graph with cycle" : "frozen (CSR) directed graph without cycle";
+    std::cout << "Graph 5: " << frozenMessage << '\n';
+
+    Graph incremental(3, true);
+    incremental.setIncrementalOrdering(true);
+    bool closesCycle = false;
+    incremental.addEdge(0, 1, closesCycle);
+    incremental.addEdge(1, 2, closesCycle);
+    incremental.addEdge(2, 0, closesCycle);
+
+    std::string incrementalMessage = closesCycle ? "edge 2 -> 0 closed a cycle on insertion" : "edge 2 -> 0 kept the graph acyclic";
+    std::cout << "Graph 6: " << incrementalMessage << '\n';
+
     return 0;
 }
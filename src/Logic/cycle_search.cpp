@@ -0,0 +1,58 @@
+#include "Logic/cycle_search.h"
+
+CycleSearch::CycleSearch(const Graph& graph)
+    : graph_(graph),
+      colors_(graph.isDirected() ? graph.vertexCount() : 0),
+      set_(graph.isDirected() ? 0 : graph.vertexCount()),
+      cursor_(nullptr, nullptr) {
+    if (!graph.isDirected() && graph.vertexCount() > 0) {
+        forest_.resize(graph.vertexCount());
+        cursor_ = graph.neighbors(0).begin();
+    }
+}
+
+void CycleSearch::closeDirectedCycle(int neighbor) {
+    // The cycle is the stack from neighbor up to the top frame, closed by the back edge.
+    int start = static_cast<int>(stack_.size()) - 1;
+    while (stack_[start].vertex != neighbor) {
+        --start;
+    }
+    const int depthCount = static_cast<int>(stack_.size());
+    for (int depth = start; depth < depthCount; ++depth) {
+        const int vertex = stack_[depth].vertex;
+        const int next = depth + 1 < depthCount ? stack_[depth + 1].vertex : neighbor;
+        witness_.vertices.push_back(vertex);
+        witness_.edges.push_back({vertex, next});
+    }
+}
+
+void CycleSearch::closeUndirectedCycle(int vertex, int neighbor) {
+    witness_.vertices.push_back(vertex);
+    if (vertex == neighbor) {
+        witness_.edges.push_back({vertex, vertex});  // self-loop
+        return;
+    }
+
+    // Both ends already share a tree: walk the forest path neighbor -> vertex to close the cycle.
+    std::vector<int> parent(graph_.vertexCount(), -1);
+    std::vector<int> queue;
+    queue.push_back(vertex);
+    parent[vertex] = vertex;
+    for (std::size_t index = 0; index < queue.size() && parent[neighbor] < 0; ++index) {
+        const int current = queue[index];
+        for (int next : forest_[current]) {
+            if (parent[next] < 0) {
+                parent[next] = current;
+                queue.push_back(next);
+            }
+        }
+    }
+
+    for (int current = neighbor; current != vertex; current = parent[current]) {
+        witness_.vertices.push_back(current);
+    }
+    for (std::size_t index = 0; index < witness_.vertices.size(); ++index) {
+        const int next = witness_.vertices[(index + 1) % witness_.vertices.size()];
+        witness_.edges.push_back({witness_.vertices[index], next});
+    }
+}
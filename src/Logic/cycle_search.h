@@ -0,0 +1,149 @@
+#pragma once
+
+#include "Logic/disjoint_set.h"
+#include "Logic/graph.h"
+#include "Logic/traversal_tracer.h"
+#include "Logic/vertex_colors.h"
+
+// CycleSearch is Graph's serial cycle detector as a resumable state machine. Every advance() performs one
+// step (a root pick, an edge, or a backtrack), reports it to the tracer, and returns false once the search
+// is over, so callers can run it to completion or pull steps lazily. The graph must not change meanwhile.
+class CycleSearch {
+public:
+    explicit CycleSearch(const Graph& graph);  // directed graphs use DFS, undirected graphs use union-find
+
+    template <typename Tracer>
+    bool advance(Tracer& tracer);  // perform one step; false when the search has finished
+
+    bool finished() const { return finished_; }  // true after the last step
+    const CycleWitness& witness() const { return witness_; }  // cycle found, empty if the graph is acyclic
+
+private:
+    struct Frame {
+        Graph::NeighborRange::Iterator next;  // next neighbor to examine
+        int vertex;
+    };
+
+    template <typename Tracer>
+    bool advanceDirected(Tracer& tracer);  // one DFS step over an explicit stack
+    template <typename Tracer>
+    bool advanceUndirected(Tracer& tracer);  // one union-find step over the edge list
+
+    void closeDirectedCycle(int neighbor);  // read the cycle off the stack at a back edge
+    void closeUndirectedCycle(int vertex, int neighbor);  // walk the spanning forest between two connected vertices
+
+    const Graph& graph_;  // graph being searched
+    CycleWitness witness_;  // result, filled when a cycle closes
+    bool finished_{false};  // no more steps to take
+    int vertex_{0};  // directed: next root candidate; undirected: vertex whose edges are being scanned
+    VertexColors colors_;  // directed: DFS state per vertex
+    std::vector<Frame> stack_;  // directed: current DFS path
+    DisjointSet set_;  // undirected: sets merged so far
+    std::vector<std::vector<int>> forest_;  // undirected: spanning forest of the merging edges
+    Graph::NeighborRange::Iterator cursor_;  // undirected: next neighbor of vertex_ to scan
+};
+
+template <typename Tracer>
+bool CycleSearch::advance(Tracer& tracer) {
+    if (finished_) {
+        return false;
+    }
+    return graph_.isDirected() ? advanceDirected(tracer) : advanceUndirected(tracer);
+}
+
+template <typename Tracer>
+bool CycleSearch::advanceDirected(Tracer& tracer) {
+    const int vertexCount = graph_.vertexCount();
+
+    if (stack_.empty()) {
+        while (vertex_ < vertexCount && colors_.get(vertex_) != VertexColors::White) {
+            ++vertex_;
+        }
+        if (vertex_ == vertexCount) {
+            finished_ = true;
+            return false;
+        }
+
+        const int root = vertex_++;
+        tracer.nodeVisited(root);
+        colors_.set(root, VertexColors::Gray);
+        stack_.push_back({graph_.neighbors(root).begin(), root});
+        return true;
+    }
+
+    Frame& frame = stack_.back();
+    if (!(frame.next != graph_.neighbors(frame.vertex).end())) {
+        tracer.nodeBacktracked(frame.vertex);
+        colors_.set(frame.vertex, VertexColors::Black);
+        stack_.pop_back();
+        return true;
+    }
+
+    const int neighbor = *frame.next;
+    ++frame.next;
+    tracer.edgeTraversed(frame.vertex, neighbor);
+
+    const VertexColors::Color color = colors_.get(neighbor);
+    if (color == VertexColors::Gray) {
+        closeDirectedCycle(neighbor);  // back edge, self-loops included
+        tracer.cycleFound(witness_);
+        finished_ = true;
+        return false;
+    }
+    if (color == VertexColors::White) {
+        tracer.nodeVisited(neighbor);
+        colors_.set(neighbor, VertexColors::Gray);
+        stack_.push_back({graph_.neighbors(neighbor).begin(), neighbor});
+    }
+    return true;
+}
+
+template <typename Tracer>
+bool CycleSearch::advanceUndirected(Tracer& tracer) {
+    const int vertexCount = graph_.vertexCount();
+
+    while (vertex_ < vertexCount) {
+        if (!(cursor_ != graph_.neighbors(vertex_).end())) {
+            if (++vertex_ < vertexCount) {
+                cursor_ = graph_.neighbors(vertex_).begin();
+            }
+            continue;
+        }
+
+        const int neighbor = *cursor_;
+        ++cursor_;
+        if (vertex_ > neighbor) {
+            continue;  // process each undirected edge once
+        }
+
+        tracer.edgeTraversed(vertex_, neighbor);
+        const int rootSource = set_.find(vertex_);
+        const int rootDestination = set_.find(neighbor);
+        if (vertex_ != neighbor && rootSource != rootDestination) {
+            set_.unionSets(rootSource, rootDestination);
+            forest_[vertex_].push_back(neighbor);
+            forest_[neighbor].push_back(vertex_);
+            tracer.setsMerged(vertex_, neighbor);
+            return true;
+        }
+
+        closeUndirectedCycle(vertex_, neighbor);  // self-loop or both ends already connected
+        tracer.cycleFound(witness_);
+        finished_ = true;
+        return false;
+    }
+
+    finished_ = true;
+    return false;
+}
+
+template <typename Tracer>
+const CycleWitness& Graph::traceCycle(Tracer& tracer) const {
+    CycleSearch search(*this);
+    while (search.advance(tracer)) {
+    }
+
+    cachedWitness_ = search.witness();
+    witnessVersion_ = version_;  // a traced run primes the memo as well
+    return cachedWitness_;
+}
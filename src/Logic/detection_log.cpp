@@ -0,0 +1,259 @@
+#include "Logic/detection_log.h"
+#include "Logic/file_util.h"
+#include "Logic/graph.h"
+
+#include <charconv>
+#include <ctime>
+#include <system_error>
+#include <utility>
+
+namespace {
+constexpr std::size_t kFlushBytes = 1 << 20;  // formatted text buffered before a write, bounds the writer's memory
+constexpr char kBanner[] = "**CYCLE DETECTION**\n\n";
+constexpr char kSeparator[] = "--------------------------------------------\n";
+
+void appendNumber(std::string& out, long long value) {
+    char digits[24];
+    const auto [end, status] = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, end);
+}
+
+void appendTimestamp(std::string& out, std::int64_t timestampMs) {
+    const std::time_t seconds = static_cast<std::time_t>(timestampMs / 1000);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &seconds);
+#else
+    localtime_r(&seconds, &local);
+#endif
+    char text[32];
+    const std::size_t length = std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%S", &local);  // ISO 8601, local time
+    out.append(text, length);
+}
+
+template <typename Range>
+void appendList(std::string& out, const Range& values) {
+    bool first = true;
+    for (int value : values) {
+        if (!first) {
+            out += ", ";
+        }
+        appendNumber(out, value);
+        first = false;
+    }
+    if (first) {
+        out += "None";
+    }
+}
+
+// Rough footprint of the graph a record keeps alive: adjacency storage, the edge index and the memoized
+// components. Only the order of magnitude matters, since it is compared with a budget of megabytes.
+std::size_t estimatedBytes(const DetectionRecord& record) {
+    constexpr std::size_t kBytesPerVertex = 48;  // list head or CSR offset, component entry, per-vertex bookkeeping
+    constexpr std::size_t kBytesPerEdge = 64;  // adjacency slot(s) plus an edge-index entry
+    std::size_t bytes = sizeof(DetectionRecord);
+    if (const Graph* graph = record.graph.get()) {
+        bytes += static_cast<std::size_t>(graph->vertexCount()) * kBytesPerVertex +
+                 static_cast<std::size_t>(graph->edgeCount()) * kBytesPerEdge;
+    }
+    return bytes;
+}
+
+std::string formatRecord(const DetectionRecord& record, std::int64_t timestampMs) {
+    const Graph* graph = record.graph.get();
+    const bool hasAdjacency = graph && graph->vertexCount() == record.vertexCount;
+    std::string out;
+    out.reserve(128 + static_cast<std::size_t>(record.vertexCount) * 24 +
+                (hasAdjacency ? static_cast<std::size_t>(graph->edgeCount()) * 16 : 0));
+    out += kSeparator;
+    out += "Timestamp: ";
+    appendTimestamp(out, timestampMs);
+    out += "\nVertex count: ";
+    appendNumber(out, record.vertexCount);
+    out += record.cyclic ? "\nCycle detected: Yes\n" : "\nCycle detected: No\n";
+
+    out += "Sets:\n";
+    if (hasAdjacency) {
+        const std::vector<std::vector<int>>& components = graph->components();  // memoized before submit(), so only read here
+        for (std::size_t setIndex = 0; setIndex < components.size(); ++setIndex) {
+            out += "  Set ";
+            appendNumber(out, static_cast<long long>(setIndex + 1));
+            out += ": ";
+            appendList(out, components[setIndex]);
+            out += '\n';
+        }
+    }
+
+    out += "Vertices:\n";
+    for (int vertex = 0; vertex < record.vertexCount; ++vertex) {
+        out += "  Vertex ";
+        appendNumber(out, vertex);
+        out += ": ";
+        if (hasAdjacency) {
+            appendList(out, graph->neighbors(vertex));
+        } else {
+            out += "None";
+        }
+        out += '\n';
+    }
+    out += '\n';
+    return out;
+}
+}
+
+DetectionLog::DetectionLog(Options options)
+    : options_(std::move(options)),
+      writer_([this] { run(); }) {
+}
+
+DetectionLog::~DetectionLog() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    writer_.join();
+}
+
+bool DetectionLog::submit(DetectionRecord record) {
+    if (queued_.fetch_add(1, std::memory_order_relaxed) >= options_.maxQueuedRecords) {
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    const std::size_t bytes = estimatedBytes(record);
+    const std::size_t queuedBefore = queuedBytes_.fetch_add(bytes, std::memory_order_relaxed);
+    if (queuedBefore > 0 && queuedBefore + bytes > options_.maxQueuedBytes) {
+        queuedBytes_.fetch_sub(bytes, std::memory_order_relaxed);
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    const std::int64_t timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                         std::chrono::system_clock::now().time_since_epoch()).count();
+    Node* node = new Node{std::move(record), timestampMs, bytes, head_.load(std::memory_order_relaxed)};
+    while (!head_.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    return true;
+}
+
+std::uint64_t DetectionLog::dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+void DetectionLog::run() {
+    bool stopping = false;
+    while (!stopping) {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            wake_.wait_for(lock, options_.flushInterval, [this] { return stopping_; });
+            stopping = stopping_;
+        }
+        if (Node* batch = head_.exchange(nullptr, std::memory_order_acquire)) {
+            writeBatch(batch);
+        }
+    }
+
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+void DetectionLog::writeBatch(Node* newestFirst) {
+    // The list comes off the stack newest first; reverse it so entries land in submission order.
+    Node* oldestFirst = nullptr;
+    while (newestFirst) {
+        Node* next = newestFirst->next;
+        newestFirst->next = oldestFirst;
+        oldestFirst = newestFirst;
+        newestFirst = next;
+    }
+
+    bool writable = file_ || openActive();
+    while (oldestFirst) {
+        Node* node = oldestFirst;
+        oldestFirst = node->next;
+        if (!writable || !append(formatRecord(node->record, node->timestampMs))) {
+            writable = false;  // a rotation that could not reopen the file loses the rest of the batch too
+            dropped_.fetch_add(1, std::memory_order_relaxed);  // surfaced through dropped() like a full queue
+        }
+        queuedBytes_.fetch_sub(node->bytes, std::memory_order_relaxed);
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        delete node;
+    }
+
+    if (file_) {
+        flushBuffer();
+        std::fflush(file_);
+    }
+}
+
+bool DetectionLog::append(const std::string& entry) {
+    const std::uintmax_t pending = fileBytes_ + buffer_.size();
+    if (pending > sizeof(kBanner) - 1 && pending + entry.size() > options_.maxFileBytes) {
+        flushBuffer();
+        rotate();
+        if (!file_) {
+            return false;
+        }
+    }
+    buffer_ += entry;
+    if (buffer_.size() >= kFlushBytes) {
+        flushBuffer();
+    }
+    return true;
+}
+
+void DetectionLog::flushBuffer() {
+    if (buffer_.empty()) {
+        return;
+    }
+    if (file_ && std::fwrite(buffer_.data(), 1, buffer_.size(), file_) == buffer_.size()) {
+        fileBytes_ += buffer_.size();
+    }
+    buffer_.clear();
+}
+
+bool DetectionLog::openActive() {
+    file_ = openFile(options_.path, "ab");
+    if (!file_) {
+        return false;
+    }
+
+    std::error_code error;
+    fileBytes_ = std::filesystem::file_size(options_.path, error);
+    if (error) {
+        fileBytes_ = 0;
+    }
+    if (fileBytes_ == 0) {
+        std::fputs(kBanner, file_);
+        fileBytes_ = sizeof(kBanner) - 1;
+    }
+    return true;
+}
+
+void DetectionLog::rotate() {
+    if (file_) {
+        std::fclose(file_);  // Windows cannot rename a file that is still open
+        file_ = nullptr;
+    }
+
+    std::error_code error;
+    const auto backup = [this](int index) {
+        std::filesystem::path name = options_.path;
+        name += "." + std::to_string(index);
+        return name;
+    };
+    if (options_.maxBackups > 0) {
+        std::filesystem::remove(backup(options_.maxBackups), error);
+        for (int index = options_.maxBackups - 1; index >= 1; --index) {
+            std::filesystem::rename(backup(index), backup(index + 1), error);
+        }
+        std::filesystem::rename(options_.path, backup(1), error);
+    } else {
+        std::filesystem::remove(options_.path, error);
+    }
+    openActive();
+}
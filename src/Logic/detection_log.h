@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class Graph;
+
+// DetectionRecord is one finished check. It shares the checked graph instead of copying its adjacency, so a
+// record costs the same to queue whatever the graph's size, and the writer does all of the formatting.
+struct DetectionRecord {
+    int vertexCount{0};
+    bool cyclic{false};
+    std::shared_ptr<const Graph> graph;  // the checked graph with components() already computed; nobody edits it again
+};
+
+// DetectionLog appends records to a text log from a background thread.
+// submit() pushes onto a lock-free list and returns at once; the writer wakes every flushInterval, formats the
+// whole batch into one buffer and writes it with a single flush. When the file would grow past maxFileBytes it
+// is rotated to path.1 ... path.maxBackups. Queued records keep their graphs alive, so the queue is bounded both
+// by count and by the estimated bytes of those graphs; a record is always accepted into an empty queue, so one
+// huge graph is still logged. Records over either bound, and records the writer cannot put in the file because it
+// does not open, are dropped and counted in dropped().
+class DetectionLog {
+public:
+    struct Options {
+        std::filesystem::path path;  // active log file
+        std::uintmax_t maxFileBytes{4u << 20};  // rotate before the active file grows past this
+        int maxBackups{3};  // rotated files kept next to the active one
+        std::size_t maxQueuedRecords{256};  // records waiting to be written
+        std::size_t maxQueuedBytes{64u << 20};  // estimated memory of the graphs those records keep alive
+        std::chrono::milliseconds flushInterval{250};  // how long records may wait to be batched
+    };
+
+    explicit DetectionLog(Options options);
+    ~DetectionLog();  // writes everything still queued, then joins the writer
+
+    DetectionLog(const DetectionLog&) = delete;
+    DetectionLog& operator=(const DetectionLog&) = delete;
+
+    bool submit(DetectionRecord record);  // stamp and queue; false when the queue was full
+    std::uint64_t dropped() const;  // records lost so far, to a full queue or to a file that would not open
+
+private:
+    struct Node {
+        DetectionRecord record;
+        std::int64_t timestampMs;  // wall clock at submit()
+        std::size_t bytes;  // estimatedBytes() charged against maxQueuedBytes
+        Node* next;
+    };
+
+    void run();  // writer loop
+    void writeBatch(Node* newestFirst);  // format, rotate and write one drained list
+    bool append(const std::string& entry);  // buffer one entry, rotating and flushing as needed; false if rotation lost the file
+    void flushBuffer();  // write buffer_ to the active file
+    bool openActive();  // open (or create) the active file and write the banner if it is empty
+    void rotate();  // shift path.N-1 -> path.N, path -> path.1
+
+    Options options_;
+    std::atomic<Node*> head_{nullptr};  // newest record first; producers push, the writer takes the whole list
+    std::atomic<std::size_t> queued_{0};  // records pushed but not yet written
+    std::atomic<std::size_t> queuedBytes_{0};  // estimated bytes those records hold
+    std::atomic<std::uint64_t> dropped_{0};  // records refused by submit() or discarded by the writer
+    std::mutex wakeMutex_;  // guards stopping_ for the sleep/wake handshake
+    std::condition_variable wake_;  // signalled only on shutdown; batching relies on the interval timeout
+    bool stopping_{false};  // set by the destructor, guarded by wakeMutex_
+    std::FILE* file_{nullptr};  // active file, owned by the writer thread
+    std::uintmax_t fileBytes_{0};  // current size of the active file
+    std::string buffer_;  // formatted text waiting for the next write
+    std::thread writer_;  // started last so every member above is ready
+};
@@ -9,6 +9,15 @@ DisjointSet::DisjointSet(int size)  // constructor definition for DisjointSet
     }
 }
 
+void DisjointSet::reset(int size)  // reinitialize without reallocating when the size is unchanged
+{
+    parent_.resize(size);  // keep capacity from earlier runs
+    rank_.assign(size, 0);  // every tree starts with rank zero
+    for (int index = 0; index < size; ++index) {  // each node becomes its own root again
+        parent_[index] = index;
+    }
+}
+
 int DisjointSet::find(int node)  // find with path compression
 {
     if (parent_[node] != node) {  // if node is not its own parent
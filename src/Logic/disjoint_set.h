@@ -1,17 +1,19 @@
 #pragma once
 
-#include <QVector>  // use Qt container to avoid STL
+#include <vector>
 
 // DisjointSet class supports union-find operations with path compression and union by rank
 class DisjointSet {
 public:
-    explicit DisjointSet(int size);  // constructor that initializes tables with given size
+    explicit DisjointSet(int size = 0);  // constructor that initializes tables with given size
+
+    void reset(int size);  // return to singleton sets of the given size, reusing storage
 
     int find(int node);  // find operation with path compression
 
     void unionSets(int firstRoot, int secondRoot);  // union by rank operation
 
 private:
-    QVector<int> parent_;  // parent array storing representative for each node
-    QVector<int> rank_;  // rank array guiding union to keep trees shallow
+    std::vector<int> parent_;  // parent array storing representative for each node
+    std::vector<int> rank_;  // rank array guiding union to keep trees shallow
 };
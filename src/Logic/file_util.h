@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdio>
+#include <filesystem>
+
+// Opens path with a C stdio mode, taking the wide-character route on Windows so non-ASCII paths survive.
+inline std::FILE* openFile(const std::filesystem::path& path, const char* mode) {
+#ifdef _WIN32
+    wchar_t wideMode[8] = {};
+    for (int index = 0; index < 7 && mode[index]; ++index) {
+        wideMode[index] = static_cast<wchar_t>(mode[index]);
+    }
+    return _wfopen(path.c_str(), wideMode);
+#else
+    return std::fopen(path.c_str(), mode);
+#endif
+}
@@ -1,35 +1,34 @@
 #include "Logic/graph.h"
-#include "Logic/disjoint_set.h"
+#include "Logic/cycle_search.h"
+#include "Logic/parallel_cycle_detector.h"
+#include "Logic/perf_counters.h"
+#include "Logic/vertex_colors.h"
 
-namespace {
-    static void collectNeighbors(const Graph::AdjNode* head, QVector<int>& out) {
-        const Graph::AdjNode* current = head;
-        while (current) {
-            out.push_back(current->dest);
-            current = current->next;
-        }
-    }
-}
+#include <algorithm>
 
 Graph::Graph(int vertexCount, bool isDirected)
-    : vertexCount_(0), isDirected_(isDirected), adjacency_(nullptr), lastError_() {
+    : vertexCount_(0), isDirected_(isDirected), adjacency_(nullptr) {
     configure(vertexCount, isDirected);
 }
 
 Graph::~Graph() {
     clearAdjacency();
+    dropCsr();  // keeps the adjacency gauge in PerfCounters balanced
 }
 
 bool Graph::configure(int vertexCount, bool isDirected) {
     if (vertexCount < 0) {
-        setError("Vertex count cannot be negative.");
+        setError(GraphError::NegativeVertexCount);
         clearAdjacency();
+        dropCsr();
         vertexCount_ = 0;
         adjacency_ = nullptr;
+        resetEdgeState();
         return false;
     }
 
     clearAdjacency();
+    dropCsr();
     vertexCount_ = vertexCount;
     isDirected_ = isDirected;
 
@@ -42,6 +41,7 @@ bool Graph::configure(int vertexCount, bool isDirected) {
         adjacency_ = nullptr;
     }
 
+    resetEdgeState();
     clearError();
     return true;
 }
@@ -51,56 +51,343 @@ void Graph::clearAdjacency() {
         return;
     }
 
+    releaseNodes();
+    delete[] adjacency_;
+    adjacency_ = nullptr;
+}
+
+void Graph::releaseNodes() {
+    if (!adjacency_) {
+        return;
+    }
+
     for (int i = 0; i < vertexCount_; ++i) {
-        AdjNode* current = adjacency_[i];
-        while (current) {
-            AdjNode* toDelete = current;
-            current = current->next;
-            delete toDelete;
-        }
         adjacency_[i] = nullptr;
     }
-    delete[] adjacency_;
-    adjacency_ = nullptr;
+    nodePool_.reset();  // nodes live in pool blocks, so nothing is freed one at a time
 }
 
 void Graph::clearEdges() {
     clearAdjacency();
+    dropCsr();
     if (vertexCount_ > 0) {
         adjacency_ = new AdjNode*[vertexCount_];
         for (int i = 0; i < vertexCount_; ++i) {
             adjacency_[i] = nullptr;
         }
     }
+    resetEdgeState();
     clearError();
 }
 
+void Graph::resetEdgeState() {
+    edgeCount_ = 0;
+    edgeIndex_.clear();
+    edgeIndexStale_ = false;
+    resetUnionFind();
+    resetIncrementalOrder();
+    bumpVersion();
+}
+
 void Graph::appendNeighbor(int source, int destination) {
-    AdjNode* node = new AdjNode{destination, adjacency_[source]};
+    AdjNode* node = nodePool_.allocate();
+    node->dest = destination;
+    node->next = adjacency_[source];
     adjacency_[source] = node;
 }
 
+void Graph::freeze() {
+    if (frozen_) {
+        return;
+    }
+
+    csrOffsets_.assign(vertexCount_ + 1, 0);
+    for (int vertex = 0; vertex < vertexCount_; ++vertex) {
+        std::int64_t degree = 0;
+        for (const AdjNode* current = adjacency_[vertex]; current; current = current->next) {
+            ++degree;
+        }
+        csrOffsets_[vertex + 1] = csrOffsets_[vertex] + degree;
+    }
+
+    csrTargets_.resize(csrOffsets_[vertexCount_]);
+    PerfCounters::instance().trackAdjacencyBytes(csrBytes());
+    for (int vertex = 0; vertex < vertexCount_; ++vertex) {
+        std::int64_t slot = csrOffsets_[vertex];
+        for (const AdjNode* current = adjacency_[vertex]; current; current = current->next) {
+            csrTargets_[slot++] = current->dest;
+        }
+    }
+
+    releaseNodes();
+    nodePool_.clear();  // the CSR arrays now own the edges, so hand the blocks back
+    csrOffsetView_ = csrOffsets_.data();
+    csrTargetView_ = csrTargets_.data();
+    frozen_ = true;
+}
+
+bool Graph::adoptCsr(int vertexCount, bool isDirected, const std::int64_t* offsets, const int* targets,
+                     std::shared_ptr<const void> owner) {
+    if (vertexCount < 0 || !offsets || (offsets[vertexCount] > 0 && !targets)) {
+        setError(GraphError::InvalidCsr);
+        return false;
+    }
+
+    // Skip configure(): the head array and per-edge index are only built if the graph is edited or queried by edge.
+    clearAdjacency();
+    dropCsr();
+    vertexCount_ = vertexCount;
+    isDirected_ = isDirected;
+    csrOffsetView_ = offsets;
+    csrTargetView_ = targets;
+    csrOwner_ = std::move(owner);
+    frozen_ = true;
+
+    resetEdgeState();
+    edgeCount_ = isDirected_ ? offsets[vertexCount] : offsets[vertexCount] / 2;  // undirected edges fill two slots, self-loops included
+    edgeIndexStale_ = true;
+    if (!isDirected_) {
+        unionFindStale_ = true;  // the edges never went through trackUndirectedEdge
+    } else if (incrementalOrder_) {
+        setIncrementalOrdering(true);  // derive predecessors and the order from the adopted edges
+    }
+    clearError();
+    return true;
+}
+
+const std::int64_t* Graph::csrOffsets() const {
+    return frozen_ ? csrOffsetView_ : nullptr;
+}
+
+const int* Graph::csrTargets() const {
+    return frozen_ ? csrTargetView_ : nullptr;
+}
+
+void Graph::thaw() {
+    if (!frozen_) {
+        return;
+    }
+
+    if (!adjacency_ && vertexCount_ > 0) {  // adopted storage never had a head array
+        adjacency_ = new AdjNode*[vertexCount_];
+        for (int i = 0; i < vertexCount_; ++i) {
+            adjacency_[i] = nullptr;
+        }
+    }
+
+    // Prepend in reverse so each list keeps the order the CSR slice had.
+    for (int vertex = 0; vertex < vertexCount_; ++vertex) {
+        for (std::int64_t slot = csrOffsetView_[vertex + 1] - 1; slot >= csrOffsetView_[vertex]; --slot) {
+            appendNeighbor(vertex, csrTargetView_[slot]);
+        }
+    }
+
+    dropCsr();
+}
+
+std::int64_t Graph::csrBytes() const {
+    return static_cast<std::int64_t>(csrOffsets_.capacity() * sizeof(std::int64_t) + csrTargets_.capacity() * sizeof(int));
+}
+
+void Graph::dropCsr() {
+    PerfCounters::instance().trackAdjacencyBytes(-csrBytes());
+    csrOffsets_.clear();
+    csrOffsets_.shrink_to_fit();
+    csrTargets_.clear();
+    csrTargets_.shrink_to_fit();
+    csrOffsetView_ = nullptr;
+    csrTargetView_ = nullptr;
+    csrOwner_.reset();
+    frozen_ = false;
+}
+
+bool Graph::isFrozen() const {
+    return frozen_;
+}
+
+Graph::NeighborRange Graph::neighbors(int vertex) const {
+    if (frozen_) {
+        return NeighborRange(NeighborRange::Iterator(nullptr, csrTargetView_ + csrOffsetView_[vertex]),
+                             NeighborRange::Iterator(nullptr, csrTargetView_ + csrOffsetView_[vertex + 1]));
+    }
+
+    const AdjNode* head = adjacency_ ? adjacency_[vertex] : nullptr;
+    return NeighborRange(NeighborRange::Iterator(head, nullptr), NeighborRange::Iterator(nullptr, nullptr));
+}
+
+bool Graph::hasEdge(int source, int destination) const {
+    if (!isValidVertex(source) || !isValidVertex(destination)) {
+        return false;
+    }
+    ensureEdgeIndex();
+    return edgeIndex_.contains(edgeKey(source, destination));
+}
+
+void Graph::ensureEdgeIndex() const {
+    if (!edgeIndexStale_) {
+        return;
+    }
+
+    for (int vertex = 0; vertex < vertexCount_; ++vertex) {
+        for (int neighbor : neighbors(vertex)) {
+            edgeIndex_.insert(edgeKey(vertex, neighbor));
+        }
+    }
+    edgeIndexStale_ = false;
+}
+
+std::uint64_t Graph::edgeKey(int source, int destination) const {
+    if (!isDirected_ && destination < source) {
+        std::swap(source, destination);  // undirected edges are stored under their (min, max) endpoints
+    }
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(source)) << 32) | static_cast<std::uint32_t>(destination);
+}
+
+int Graph::degree(int vertex) const {
+    if (frozen_) {
+        return static_cast<int>(csrOffsetView_[vertex + 1] - csrOffsetView_[vertex]);
+    }
+
+    int count = 0;
+    for (const AdjNode* current = adjacency_ ? adjacency_[vertex] : nullptr; current; current = current->next) {
+        ++count;
+    }
+    return count;
+}
+
 bool Graph::addEdge(int source, int destination) {
+    return insertEdge(source, destination, nullptr);
+}
+
+bool Graph::addEdge(int source, int destination, bool& closesCycle) {
+    return insertEdge(source, destination, &closesCycle);
+}
+
+bool Graph::insertEdge(int source, int destination, bool* closesCycle) {
+    ScopedPerfTimer timer(PerfOp::AddEdge);
     if (!isValidVertex(source) || !isValidVertex(destination)) {
-        setError("Ignored edge with out-of-range endpoint(s).");
+        setError(GraphError::VertexOutOfRange);
         return false;
     }
 
-    appendNeighbor(source, destination);
-    if (!isDirected_) {
+    ensureEdgeIndex();
+    const std::uint64_t key = edgeKey(source, destination);
+    if (edgeIndex_.contains(key)) {
+        setError(GraphError::DuplicateEdge);
+        return false;
+    }
+
+    thaw();
+    edgeIndex_.insert(key);
+
+    bool closes = false;
+    if (isDirected_) {
+        if (incrementalOrder_) {
+            if (orderStale_) {
+                recomputeTopologicalOrder();
+            }
+            if (directedCycle_) {
+                closes = closesCycle && reaches(destination, source);  // order is meaningless once a cycle exists
+            } else {
+                closes = reorderForEdge(source, destination);
+                directedCycle_ = closes;
+            }
+            predecessors_[destination].push_back(source);
+        } else if (closesCycle) {
+            closes = reaches(destination, source);
+        }
+        appendNeighbor(source, destination);
+    } else {
+        if (unionFindStale_ && closesCycle) {
+            rebuildUnionFind();
+        }
+        appendNeighbor(source, destination);
         appendNeighbor(destination, source);
+        if (!unionFindStale_) {
+            closes = trackUndirectedEdge(source, destination);
+        }
     }
 
+    if (closesCycle) {
+        *closesCycle = closes;
+    }
+    ++edgeCount_;
+    bumpVersion();
     clearError();
     return true;
 }
 
+int Graph::addEdges(std::span<const std::pair<int, int>> edges) {
+    ScopedPerfTimer timer(PerfOp::AddEdges);
+    if (edges.empty()) {
+        clearError();
+        return 0;
+    }
+
+    ensureEdgeIndex();
+    thaw();
+    const std::size_t needed = edgeIndex_.size() + edges.size();
+    if (needed > edgeIndex_.bucket_count() * edgeIndex_.max_load_factor()) {
+        edgeIndex_.reserve(std::max(needed, 2 * edgeIndex_.size()));  // grow geometrically so batched loads do not rehash per batch
+    }
+    nodePool_.reserve(static_cast<std::int64_t>(edges.size()) * (isDirected_ ? 1 : 2));
+
+    int added = 0;
+    int skipped = 0;
+    for (const auto& [source, destination] : edges) {
+        if (!isValidVertex(source) || !isValidVertex(destination)) {
+            ++skipped;
+            continue;
+        }
+        if (!edgeIndex_.insert(edgeKey(source, destination)).second) {  // one hash probe both rejects and records
+            ++skipped;
+            continue;
+        }
+
+        appendNeighbor(source, destination);
+        if (isDirected_) {
+            if (incrementalOrder_) {
+                predecessors_[destination].push_back(source);
+            }
+        } else {
+            appendNeighbor(destination, source);
+            if (!unionFindStale_) {
+                trackUndirectedEdge(source, destination);
+            }
+        }
+        ++added;
+    }
+
+    if (incrementalOrder_ && isDirected_ && added > 0) {
+        orderStale_ = true;  // one Kahn pass on the next query beats a Pearce-Kelly update per edge
+    }
+    if (added > 0) {
+        edgeCount_ += added;
+        bumpVersion();
+    }
+
+    if (skipped > 0) {
+        setError(GraphError::SkippedEdges);  // callers compare the return value with their batch size for the count
+    } else {
+        clearError();
+    }
+    return added;
+}
+
 bool Graph::removeEdge(int source, int destination) {
+    ScopedPerfTimer timer(PerfOp::RemoveEdge);
     if (!isValidVertex(source) || !isValidVertex(destination)) {
-        setError("Ignored removal with out-of-range endpoint(s).");
+        setError(GraphError::VertexOutOfRange);
         return false;
     }
 
+    // Reject a missing edge before thaw(), so a failed removal leaves a frozen or adopted graph frozen.
+    ensureEdgeIndex();
+    if (!edgeIndex_.contains(edgeKey(source, destination))) {
+        setError(GraphError::MissingEdge);
+        return false;
+    }
+    thaw();
     auto removeNeighbor = [this](int from, int to) {
         AdjNode* prev = nullptr;
         AdjNode* current = adjacency_[from];
@@ -111,7 +398,7 @@ bool Graph::removeEdge(int source, int destination) {
                 } else {
                     adjacency_[from] = current->next;
                 }
-                delete current;
+                nodePool_.release(current);
                 return true;
             }
             prev = current;
@@ -126,95 +413,326 @@ bool Graph::removeEdge(int source, int destination) {
     }
 
     if (removed) {
+        --edgeCount_;
+        edgeIndex_.erase(edgeKey(source, destination));
+        if (!isDirected_) {
+            unionFindStale_ = true;  // union-find cannot split sets, so rebuild lazily on the next query
+        } else if (incrementalOrder_) {
+            std::vector<int>& incoming = predecessors_[destination];
+            const auto position = std::find(incoming.begin(), incoming.end(), source);
+            if (position != incoming.end()) {
+                *position = incoming.back();
+                incoming.pop_back();
+            }
+            if (directedCycle_) {
+                orderStale_ = true;  // an acyclic order survives removals, but a cyclic graph may have become acyclic
+            }
+        }
+        bumpVersion();
         clearError();
         return true;
     }
 
-    setError("Ignored removal for non-existent edge.");
+    setError(GraphError::MissingEdge);
     return false;
 }
 
-bool Graph::detectCycle() const {
+bool Graph::detectCycle(ExecutionPolicy policy) const {
+    ScopedPerfTimer timer(PerfOp::DetectCycle);
     if (vertexCount_ <= 0) {
         clearError();
         return false;
     }
 
-    if (isDirected_) {
-        return detectCycleDirected();
+    if (cycleVersion_ != version_) {
+        cachedCycle_ = isDirected_ ? detectCycleDirected(policy) : detectCycleUndirected(policy);
+        cycleVersion_ = version_;
+    }
+    return cachedCycle_;
+}
+
+const CycleWitness& Graph::cycleWitness() const {
+    if (witnessVersion_ == version_) {
+        return cachedWitness_;
     }
 
-    return detectCycleUndirected();
+    NullTraversalTracer tracer;
+    return traceCycle(tracer);
 }
 
-bool Graph::detectCycleUndirected() const {
+const std::vector<std::vector<int>>& Graph::components() const {
+    if (componentsVersion_ == version_) {
+        return cachedComponents_;
+    }
+
     DisjointSet set(vertexCount_);
+    for (int vertex = 0; vertex < vertexCount_; ++vertex) {
+        for (int neighbor : neighbors(vertex)) {
+            set.unionSets(set.find(vertex), set.find(neighbor));
+        }
+    }
 
+    // Number components in order of their smallest vertex so the grouping is stable.
+    std::vector<int> componentOfRoot(vertexCount_, -1);
+    cachedComponents_.clear();
     for (int vertex = 0; vertex < vertexCount_; ++vertex) {
-        const AdjNode* current = adjacency_ ? adjacency_[vertex] : nullptr;
-        while (current) {
-            const int neighbor = current->dest;
-            if (vertex == neighbor) {
-                return true;  // self-loop
-            }
+        const int root = set.find(vertex);
+        if (componentOfRoot[root] < 0) {
+            componentOfRoot[root] = static_cast<int>(cachedComponents_.size());
+            cachedComponents_.push_back(std::vector<int>());
+        }
+        cachedComponents_[componentOfRoot[root]].push_back(vertex);
+    }
 
-            if (vertex < neighbor) {  // process each undirected edge once
-                int rootSource = set.find(vertex);
-                int rootDestination = set.find(neighbor);
+    componentsVersion_ = version_;
+    return cachedComponents_;
+}
 
-                if (rootSource == rootDestination) {
-                    return true;
-                }
+std::uint64_t Graph::version() const {
+    return version_;
+}
+
+void Graph::bumpVersion() {
+    ++version_;
+}
 
-                set.unionSets(rootSource, rootDestination);
+bool Graph::detectCycleUndirected(ExecutionPolicy policy) const {
+    if (!unionFindStale_) {
+        return undirectedCycle_;
+    }
+
+    // After a removal the persistent union-find must be rebuilt; large graphs answer with a parallel scan
+    // instead and leave the sequential rebuild to the next insertion that needs it.
+    if (useParallelEngine(policy)) {
+        return ParallelCycleDetector().hasUndirectedCycle(*this);
+    }
+
+    rebuildUnionFind();
+    return undirectedCycle_;
+}
+
+bool Graph::trackUndirectedEdge(int source, int destination) const {
+    if (source == destination) {
+        undirectedCycle_ = true;  // self-loop
+        return true;
+    }
+
+    const int rootSource = unionFind_.find(source);
+    const int rootDestination = unionFind_.find(destination);
+    if (rootSource == rootDestination) {
+        undirectedCycle_ = true;
+        return true;
+    }
+
+    unionFind_.unionSets(rootSource, rootDestination);
+    return false;
+}
+
+void Graph::rebuildUnionFind() const {
+    unionFind_.reset(vertexCount_);
+    undirectedCycle_ = false;
+    unionFindStale_ = false;
+
+    for (int vertex = 0; vertex < vertexCount_; ++vertex) {
+        for (int neighbor : neighbors(vertex)) {
+            if (vertex <= neighbor) {  // process each undirected edge once
+                trackUndirectedEdge(vertex, neighbor);
             }
-            current = current->next;
         }
     }
+}
 
-    return false;
+void Graph::resetUnionFind() {
+    unionFind_.reset(isDirected_ ? 0 : vertexCount_);
+    undirectedCycle_ = false;
+    unionFindStale_ = false;
+}
+
+void Graph::setIncrementalOrdering(bool enabled) {
+    incrementalOrder_ = enabled;
+    resetIncrementalOrder();
+    if (!incrementalOrder_ || !isDirected_) {
+        return;
+    }
+
+    for (int vertex = 0; vertex < vertexCount_; ++vertex) {
+        for (int neighbor : neighbors(vertex)) {
+            predecessors_[neighbor].push_back(vertex);
+        }
+    }
+    recomputeTopologicalOrder();
 }
 
-bool Graph::detectCycleDirected() const {
-    QVector<bool> visited(vertexCount_, false);
-    QVector<bool> recursionStack(vertexCount_, false);
+bool Graph::isIncrementalOrdering() const {
+    return incrementalOrder_;
+}
 
+void Graph::resetIncrementalOrder() {
+    directedCycle_ = false;
+    orderStale_ = false;
+    searchEpoch_ = 0;
+    forwardSet_.clear();
+    backwardSet_.clear();
+    positions_.clear();
+
+    if (!incrementalOrder_ || !isDirected_) {
+        predecessors_.clear();
+        order_.clear();
+        searchMark_.clear();
+        return;
+    }
+
+    predecessors_.assign(vertexCount_, std::vector<int>());
+    searchMark_.assign(vertexCount_, 0);
+    order_.resize(vertexCount_);
     for (int vertex = 0; vertex < vertexCount_; ++vertex) {
-        if (!visited[vertex]) {
-            if (depthFirstDetectDirected(vertex, visited, recursionStack)) {
-                return true;
+        order_[vertex] = vertex;  // with no edges every permutation is topological
+    }
+}
+
+bool Graph::reorderForEdge(int source, int destination) {
+    // Pearce-Kelly: only vertices whose order lies between destination and source can be affected.
+    if (source == destination) {
+        return true;  // self-loop
+    }
+
+    const int lowerBound = order_[destination];
+    const int upperBound = order_[source];
+    if (upperBound < lowerBound) {
+        return false;  // source already precedes destination
+    }
+
+    if (++searchEpoch_ == 0) {  // stamp wrapped around, clear the marks once
+        std::fill(searchMark_.begin(), searchMark_.end(), 0);
+        searchEpoch_ = 1;
+    }
+
+    // Forward search from destination, bounded above by source's position.
+    forwardSet_.clear();
+    forwardSet_.push_back(destination);
+    searchMark_[destination] = searchEpoch_;
+    for (std::size_t index = 0; index < forwardSet_.size(); ++index) {
+        for (int neighbor : neighbors(forwardSet_[index])) {
+            if (neighbor == source) {
+                return true;  // destination already reaches source
+            }
+            if (searchMark_[neighbor] != searchEpoch_ && order_[neighbor] < upperBound) {
+                searchMark_[neighbor] = searchEpoch_;
+                forwardSet_.push_back(neighbor);
             }
         }
     }
 
+    // Backward search from source, bounded below by destination's position.
+    backwardSet_.clear();
+    backwardSet_.push_back(source);
+    searchMark_[source] = searchEpoch_;
+    for (std::size_t index = 0; index < backwardSet_.size(); ++index) {
+        for (int predecessor : predecessors_[backwardSet_[index]]) {
+            if (searchMark_[predecessor] != searchEpoch_ && order_[predecessor] > lowerBound) {
+                searchMark_[predecessor] = searchEpoch_;
+                backwardSet_.push_back(predecessor);
+            }
+        }
+    }
+
+    // Hand the pooled positions back out: everything reaching source first, then everything reached from destination.
+    const auto byOrder = [this](int first, int second) { return order_[first] < order_[second]; };
+    std::sort(backwardSet_.begin(), backwardSet_.end(), byOrder);
+    std::sort(forwardSet_.begin(), forwardSet_.end(), byOrder);
+
+    positions_.clear();
+    for (int vertex : backwardSet_) {
+        positions_.push_back(order_[vertex]);
+    }
+    for (int vertex : forwardSet_) {
+        positions_.push_back(order_[vertex]);
+    }
+    std::inplace_merge(positions_.begin(), positions_.begin() + static_cast<std::ptrdiff_t>(backwardSet_.size()), positions_.end());  // both halves are already sorted
+
+    int next = 0;
+    for (int vertex : backwardSet_) {
+        order_[vertex] = positions_[next++];
+    }
+    for (int vertex : forwardSet_) {
+        order_[vertex] = positions_[next++];
+    }
     return false;
 }
 
-bool Graph::depthFirstDetectDirected(int vertex, QVector<bool>& visited, QVector<bool>& recursionStack) const {
-    visited[vertex] = true;
-    recursionStack[vertex] = true;
+void Graph::recomputeTopologicalOrder() const {
+    std::vector<int> inDegree(vertexCount_, 0);
+    for (int vertex = 0; vertex < vertexCount_; ++vertex) {
+        for (int neighbor : neighbors(vertex)) {
+            ++inDegree[neighbor];
+        }
+    }
 
-    const AdjNode* current = adjacency_ ? adjacency_[vertex] : nullptr;
-    while (current) {
-        const int neighbor = current->dest;
-        if (vertex == neighbor) {
-            return true;  // self-loop
+    std::vector<int> ready;
+    ready.reserve(vertexCount_);
+    for (int vertex = 0; vertex < vertexCount_; ++vertex) {
+        if (inDegree[vertex] == 0) {
+            ready.push_back(vertex);
         }
+    }
 
-        if (!visited[neighbor]) {
-            if (depthFirstDetectDirected(neighbor, visited, recursionStack)) {
-                return true;
+    for (int index = 0; index < static_cast<int>(ready.size()); ++index) {
+        const int vertex = ready[index];
+        order_[vertex] = index;
+        for (int neighbor : neighbors(vertex)) {
+            if (--inDegree[neighbor] == 0) {
+                ready.push_back(neighbor);
             }
-        } else if (recursionStack[neighbor]) {
+        }
+    }
+
+    directedCycle_ = static_cast<int>(ready.size()) < vertexCount_;  // vertices left over sit on or behind a cycle
+    orderStale_ = false;
+}
+
+bool Graph::reaches(int from, int to) const {
+    VertexColors colors(vertexCount_);
+    std::vector<int> pending;
+    pending.push_back(from);
+    colors.set(from, VertexColors::Black);
+
+    while (!pending.empty()) {
+        const int vertex = pending.back();
+        pending.pop_back();
+        if (vertex == to) {
             return true;
         }
-        current = current->next;
+        for (int neighbor : neighbors(vertex)) {
+            if (colors.get(neighbor) == VertexColors::White) {
+                colors.set(neighbor, VertexColors::Black);
+                pending.push_back(neighbor);
+            }
+        }
     }
 
-    recursionStack[vertex] = false;
     return false;
 }
 
+bool Graph::detectCycleDirected(ExecutionPolicy policy) const {
+    if (incrementalOrder_) {
+        if (orderStale_) {
+            recomputeTopologicalOrder();
+        }
+        return directedCycle_;
+    }
+
+    if (useParallelEngine(policy)) {
+        return ParallelCycleDetector().hasDirectedCycle(*this);
+    }
+
+    return !cycleWitness().isEmpty();
+}
+
+bool Graph::useParallelEngine(ExecutionPolicy policy) const {
+    return policy == ExecutionPolicy::Parallel ||
+           (policy == ExecutionPolicy::Automatic && vertexCount_ >= kParallelVertexThreshold);
+}
+
 bool Graph::isValidVertex(int index) const {
     return index >= 0 && index < vertexCount_;
 }
@@ -227,25 +745,28 @@ int Graph::vertexCount() const {
     return vertexCount_;
 }
 
-QVector<QVector<int>> Graph::getAdjacencyList() const {
-    QVector<QVector<int>> view(vertexCount_);
-    if (!adjacency_) {
-        return view;
-    }
+std::int64_t Graph::edgeCount() const {
+    return edgeCount_;
+}
+
+std::vector<std::vector<int>> Graph::getAdjacencyList() const {
+    std::vector<std::vector<int>> view(vertexCount_);
     for (int vertex = 0; vertex < vertexCount_; ++vertex) {
-        collectNeighbors(adjacency_[vertex], view[vertex]);
+        for (int neighbor : neighbors(vertex)) {
+            view[vertex].push_back(neighbor);
+        }
     }
     return view;
 }
 
-const QString& Graph::getLastError() const {
+GraphError Graph::getLastError() const {
     return lastError_;
 }
 
-void Graph::setError(const QString& message) const {
-    lastError_ = message;
+void Graph::setError(GraphError error) const {
+    lastError_ = error;
 }
 
 void Graph::clearError() const {
-    lastError_.clear();
+    lastError_ = GraphError::None;
 }
\ No newline at end of file
@@ -1,7 +1,34 @@
 #pragma once
 using namespace std;
-#include <QVector>   // use Qt containers instead of STL vectors
-#include <QString>   // use Qt string instead of std::string
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_set>  // hashed edge index
+#include <utility>
+#include <vector>
+
+#include "Logic/disjoint_set.h"
+#include "Logic/graph_error.h"
+#include "Logic/node_pool.h"
+
+// ExecutionPolicy selects between the single-threaded detectors and the multi-threaded engine
+enum class ExecutionPolicy {
+    Serial,  // always run the single-threaded algorithms
+    Parallel,  // always use the multi-threaded engines
+    Automatic  // go parallel only once the graph is large enough to pay for the threads
+};
+
+// CycleWitness describes one concrete cycle: edges[i] leaves vertices[i] and the last edge returns to vertices[0]
+struct CycleWitness {
+    struct Edge {
+        int source;
+        int target;
+    };
+
+    std::vector<int> vertices;  // cycle vertices in traversal order
+    std::vector<Edge> edges;  // cycle edges in traversal order, one per vertex
+    bool isEmpty() const { return vertices.empty(); }
+};
 
 // Graph class represents a graph that can be directed or undirected using an adjacency list
 class Graph {
@@ -11,34 +38,138 @@ public:
         AdjNode* next;
     };
 
+    // Read-only view over the neighbors of one vertex, walking either a linked list or a CSR slice.
+    class NeighborRange {
+    public:
+        class Iterator {
+        public:
+            Iterator(const AdjNode* node, const int* slot) : node_(node), slot_(slot) {}
+            int operator*() const { return node_ ? node_->dest : *slot_; }
+            Iterator& operator++() {
+                if (node_) {
+                    node_ = node_->next;
+                } else {
+                    ++slot_;
+                }
+                return *this;
+            }
+            bool operator!=(const Iterator& other) const { return node_ != other.node_ || slot_ != other.slot_; }
+
+        private:
+            const AdjNode* node_;  // current list node, or nullptr when iterating CSR storage
+            const int* slot_;  // current CSR slot, or nullptr when iterating a linked list
+        };
+
+        NeighborRange(Iterator first, Iterator last) : first_(first), last_(last) {}
+        Iterator begin() const { return first_; }
+        Iterator end() const { return last_; }
+
+    private:
+        Iterator first_;
+        Iterator last_;
+    };
+
     Graph(int vertexCount = 0, bool isDirected = false);  // constructor that records vertex count and edge direction mode
     ~Graph();  // destructor to free adjacency lists
 
     bool configure(int vertexCount, bool isDirected);  // allow GUI to reconfigure vertex/direction without recreating object
     void clearEdges();  // drop all existing edges while keeping current configuration
-    bool addEdge(int source, int destination);  // method to add an edge and report validation errors
+    bool addEdge(int source, int destination);  // method to add an edge and report validation errors (duplicates are rejected)
+    bool addEdge(int source, int destination, bool& closesCycle);  // same, also reporting whether the new edge lies on a cycle
+    int addEdges(std::span<const std::pair<int, int>> edges);  // batch insert; returns how many edges were added, skipped ones are summarized in lastError
     bool removeEdge(int source, int destination);  // allow the UI to remove an existing edge
+    bool hasEdge(int source, int destination) const;  // O(1) lookup in the hashed edge index
+
+    // Compact adjacency lists into contiguous CSR arrays for fast read-only traversal. The first accepted edit after
+    // that (rejected duplicates and missing edges do not count) thaws the whole graph back into lists, O(V + E),
+    // and it stays thawed; finish a batch of edits before freezing, since alternating freeze() with single edits
+    // turns an edit loop quadratic.
+    void freeze();
+    bool isFrozen() const;  // report whether the graph currently lives in CSR form
+    bool adoptCsr(int vertexCount, bool isDirected, const std::int64_t* offsets, const int* targets,
+                  std::shared_ptr<const void> owner);  // borrow external CSR arrays (e.g. a mapped snapshot) without copying; owner keeps them alive; edits thaw as after freeze()
+    const std::int64_t* csrOffsets() const;  // CSR row offsets while frozen, nullptr otherwise
+    const int* csrTargets() const;  // CSR neighbor ids while frozen, nullptr otherwise
+
+    void setIncrementalOrdering(bool enabled);  // keep a dynamic topological order so directed insertions detect cycles on the spot
+    bool isIncrementalOrdering() const;  // report whether the dynamic topological order is maintained
 
-    bool detectCycle() const;  // method to detect cycles using the appropriate strategy
+    bool detectCycle(ExecutionPolicy policy = ExecutionPolicy::Automatic) const;  // detect cycles with the appropriate strategy, memoized per version
+    const CycleWitness& cycleWitness() const;  // one cycle found in the same pass as detection, empty when acyclic; memoized per version
+    template <typename Tracer>
+    const CycleWitness& traceCycle(Tracer& tracer) const;  // rerun the serial detector, reporting each step to tracer (defined in cycle_search.h)
+    const std::vector<std::vector<int>>& components() const;  // weakly connected components (edge direction ignored), memoized per version
+    std::uint64_t version() const;  // mutation counter bumped by addEdge, removeEdge, clearEdges and configure
 
     bool isDirected() const;  // expose configuration for GUI rendering
     int vertexCount() const;  // expose vertex count for GUI rendering
-    QVector<QVector<int>> getAdjacencyList() const;  // allow GUI to inspect adjacency data
-    const QString& getLastError() const;  // expose last validation or processing error
+    std::int64_t edgeCount() const;  // number of stored edges (an undirected edge counts once)
+    NeighborRange neighbors(int vertex) const;  // zero-copy view of a vertex's neighbors, valid until the next edit
+    int degree(int vertex) const;  // number of stored neighbors of a vertex
+    std::vector<std::vector<int>> getAdjacencyList() const;  // deep copy of the adjacency data (prefer neighbors())
+    GraphError getLastError() const;  // expose last validation or processing error (errorMessage() gives the text)
 
 private:
-    bool detectCycleUndirected() const;  // helper dedicated to undirected cycle detection via Union-Find
-    bool detectCycleDirected() const;  // helper dedicated to directed cycle detection via DFS recursion
-    bool depthFirstDetectDirected(int vertex, QVector<bool>& visited, QVector<bool>& recursionStack) const;  // recursive DFS utility
+    bool detectCycleUndirected(ExecutionPolicy policy) const;  // helper dedicated to undirected cycle detection via Union-Find
+    bool trackUndirectedEdge(int source, int destination) const;  // fold one undirected edge into the union-find; true if it closes a cycle
+    void rebuildUnionFind() const;  // rescan every edge after a removal invalidated the union-find
+    void resetUnionFind();  // start an empty union-find sized for the current configuration
+    bool insertEdge(int source, int destination, bool* closesCycle);  // shared body of both addEdge overloads
+    bool reorderForEdge(int source, int destination);  // Pearce-Kelly update; true when the edge closes a cycle
+    void recomputeTopologicalOrder() const;  // Kahn pass that rebuilds order_ or flags a directed cycle
+    void resetIncrementalOrder();  // identity order and empty predecessor lists for the current configuration
+    bool reaches(int from, int to) const;  // plain reachability search used when no order is available
+    bool detectCycleDirected(ExecutionPolicy policy) const;  // helper dedicated to directed cycle detection via iterative DFS or parallel trimming
+    bool useParallelEngine(ExecutionPolicy policy) const;  // resolve the policy against the graph size
     bool isValidVertex(int index) const;  // helper to verify vertex indices before use
-    void setError(const QString& message) const;  // record a human-readable error for GUI consumption
+    void setError(GraphError error) const;  // record the error code for GUI consumption
     void clearError() const;  // reset error indicator when operations succeed
+    void bumpVersion();  // record a mutation so memoized analysis results are recomputed
 
     void clearAdjacency();  // free all adjacency nodes
+    void releaseNodes();  // detach every list node and recycle the pool blocks, keeping the head array
+    void thaw();  // expand CSR arrays back into linked lists before an edit
+    void dropCsr();  // release CSR arrays without touching the linked lists
+    std::int64_t csrBytes() const;  // heap bytes held by the owned CSR arrays (adopted storage is not counted)
     void appendNeighbor(int source, int destination);  // add neighbor to adjacency list
+    void resetEdgeState();  // forget per-edge bookkeeping after the edge set was emptied
+    void ensureEdgeIndex() const;  // rebuild edgeIndex_ from the stored edges if it was skipped on load
+    std::uint64_t edgeKey(int source, int destination) const;  // hash key for an edge, orientation-free when undirected
 
     int vertexCount_;  // number of vertices in the graph
     bool isDirected_;  // flag indicating whether edges should be treated as directed or undirected
+    std::int64_t edgeCount_{0};  // edges currently stored, maintained by every mutation
     AdjNode** adjacency_{nullptr};  // array of adjacency list heads (linked lists)
-    mutable QString lastError_;  // stores the most recent error so GUI can display it even from const methods
+    NodePool<AdjNode> nodePool_;  // block allocator backing every AdjNode
+    mutable std::unordered_set<std::uint64_t> edgeIndex_;  // every stored edge keyed by edgeKey(), for O(1) lookup and duplicate rejection
+    mutable bool edgeIndexStale_{false};  // set by adoptCsr; the first lookup builds edgeIndex_ instead of the load
+    std::vector<std::int64_t> csrOffsets_;  // CSR row offsets into csrTargets_, vertexCount_ + 1 entries when frozen
+    std::vector<int> csrTargets_;  // CSR neighbor ids stored contiguously by source vertex
+    const std::int64_t* csrOffsetView_{nullptr};  // offsets actually traversed: csrOffsets_ or adopted external storage
+    const int* csrTargetView_{nullptr};  // targets actually traversed: csrTargets_ or adopted external storage
+    std::shared_ptr<const void> csrOwner_;  // keeps adopted external arrays alive
+    bool frozen_{false};  // true when csr arrays hold the edges and the linked lists are empty
+    mutable DisjointSet unionFind_;  // persistent union-find over undirected edges, updated on every insertion
+    mutable bool undirectedCycle_{false};  // cached undirected cycle flag maintained alongside unionFind_
+    mutable bool unionFindStale_{false};  // set by removeEdge; the next query rebuilds unionFind_ from scratch
+    bool incrementalOrder_{false};  // true when the dynamic topological order below is maintained
+    std::vector<std::vector<int>> predecessors_;  // reverse adjacency used by the backward search
+    mutable std::vector<int> order_;  // order_[v] is v's position in the current topological order
+    mutable bool directedCycle_{false};  // cached directed cycle flag while incremental ordering is on
+    mutable bool orderStale_{false};  // set when a removal may have broken the last known cycle
+    std::vector<int> searchMark_;  // epoch stamps so each reorder only touches the vertices it visits
+    int searchEpoch_{0};  // current stamp written into searchMark_
+    std::vector<int> forwardSet_;  // scratch: vertices reached forward from the new edge's destination
+    std::vector<int> backwardSet_;  // scratch: vertices reaching the new edge's source
+    std::vector<int> positions_;  // scratch: the order slots freed by both sets, handed back out in sorted order
+    static constexpr int kParallelVertexThreshold = 1 << 17;  // below this, thread start-up costs more than the serial DFS
+    static constexpr std::uint64_t kNotCached = ~std::uint64_t(0);  // version stamp meaning "never computed"
+    std::uint64_t version_{0};  // incremented on every structural change
+    mutable std::uint64_t cycleVersion_{kNotCached};  // version the cached cycle flag belongs to
+    mutable bool cachedCycle_{false};  // memoized detectCycle() result
+    mutable std::uint64_t witnessVersion_{kNotCached};  // version the cached witness belongs to
+    mutable CycleWitness cachedWitness_;  // memoized cycleWitness() result
+    mutable std::uint64_t componentsVersion_{kNotCached};  // version the cached components belong to
+    mutable std::vector<std::vector<int>> cachedComponents_;  // memoized components() result
+    mutable GraphError lastError_{GraphError::None};  // stores the most recent error so GUI can display it even from const methods
 };
@@ -0,0 +1,27 @@
+#include "Logic/graph_error.h"
+
+const char* errorMessage(GraphError error) {
+    switch (error) {
+    case GraphError::None: return "No error.";
+    case GraphError::NegativeVertexCount: return "Vertex count cannot be negative.";
+    case GraphError::VertexOutOfRange: return "Ignored edge with out-of-range endpoint(s).";
+    case GraphError::DuplicateEdge: return "Ignored duplicate edge.";
+    case GraphError::MissingEdge: return "Ignored removal for non-existent edge.";
+    case GraphError::SkippedEdges: return "Ignored out-of-range or duplicate edge(s).";
+    case GraphError::InvalidCsr: return "Ignored invalid CSR arrays.";
+    case GraphError::OpenFailed: return "Could not open the file.";
+    case GraphError::ReadFailed: return "Read error.";
+    case GraphError::WriteFailed: return "Write error.";
+    case GraphError::MapFailed: return "Could not map the file.";
+    case GraphError::VertexIdTooLarge: return "A vertex id does not fit the graph.";
+    case GraphError::GraphTooLarge: return "The graph exceeds the size limit.";
+    case GraphError::InvalidProblemLine: return "Invalid DIMACS problem line.";
+    case GraphError::MissingProblemLine: return "Missing DIMACS problem line.";
+    case GraphError::NotASnapshot: return "Not a graph snapshot.";
+    case GraphError::IncompatibleSnapshot: return "Snapshot was written by an incompatible version or byte order.";
+    case GraphError::CorruptSnapshot: return "Snapshot is truncated or corrupt.";
+    case GraphError::ChecksumMismatch: return "Snapshot checksum mismatch.";
+    case GraphError::InvalidGeneratorArguments: return "Generator arguments do not describe a valid graph.";
+    }
+    return "Unknown error.";
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+// GraphError is the status every Logic class records instead of a message string, so failing calls never allocate.
+// errorMessage() turns a code into fixed English text for logs and the GUI.
+enum class GraphError {
+    None,  // the last call succeeded
+
+    // Graph
+    NegativeVertexCount,  // configure() with a negative count
+    VertexOutOfRange,  // an edge endpoint outside [0, vertexCount)
+    DuplicateEdge,  // addEdge() for an edge that is already stored
+    MissingEdge,  // removeEdge() for an edge that is not stored
+    SkippedEdges,  // addEdges() dropped some out-of-range or duplicate pairs; the return value says how many were kept
+    InvalidCsr,  // adoptCsr() with missing arrays or a negative count
+
+    // Files
+    OpenFailed,  // the file could not be opened or created
+    ReadFailed,  // an I/O error while reading
+    WriteFailed,  // an I/O error while writing
+    MapFailed,  // the operating system refused to map the file
+    VertexIdTooLarge,  // an edge list names a vertex beyond the int range
+    GraphTooLarge,  // a file holds more vertices or edge lines than GraphImporter::setSizeLimit() allows
+    InvalidProblemLine,  // a DIMACS "p" line is malformed or repeated
+    MissingProblemLine,  // a DIMACS file has no "p" line
+    NotASnapshot,  // the file does not start with the snapshot magic
+    IncompatibleSnapshot,  // written by another format version or byte order
+    CorruptSnapshot,  // header and file size or array bounds disagree
+    ChecksumMismatch,  // verification found a changed byte or an out-of-range id
+
+    // Generators
+    InvalidGeneratorArguments  // sizes or counts that no graph of the requested kind can satisfy
+};
+
+const char* errorMessage(GraphError error);  // static text, never null
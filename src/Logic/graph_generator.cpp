@@ -0,0 +1,222 @@
+#include "Logic/graph_generator.h"
+#include "Logic/graph.h"
+
+#include <algorithm>
+#include <climits>
+#include <span>
+
+namespace {
+constexpr std::size_t kBatchEdges = 1 << 16;  // edges handed to Graph::addEdges at a time
+constexpr int kMinPlantedCycle = 2;  // shortest planted cycle (two opposite edges)
+constexpr int kMaxPlantedCycle = 8;  // longest planted cycle
+
+std::int64_t maxSimpleEdges(int vertexCount, bool directed) {
+    const std::int64_t pairs = static_cast<std::int64_t>(vertexCount) * (vertexCount - 1);
+    return directed ? pairs : pairs / 2;
+}
+}
+
+GraphGenerator::GraphGenerator(std::uint64_t seed)
+    : random_(seed) {
+    batch_.reserve(kBatchEdges);
+}
+
+bool GraphGenerator::erdosRenyi(Graph& graph, int vertexCount, std::int64_t edgeCount, bool directed) {
+    if (vertexCount < 0 || edgeCount < 0 || edgeCount > maxSimpleEdges(vertexCount, directed)) {
+        return fail(GraphError::InvalidGeneratorArguments);
+    }
+
+    graph.configure(vertexCount, directed);
+    // Draw the missing number of edges, let the graph's edge index drop repeats, and top up until exact.
+    while (graph.edgeCount() < edgeCount) {
+        const std::int64_t missing = edgeCount - graph.edgeCount();
+        for (std::int64_t drawn = 0; drawn < missing;) {
+            const int source = uniform(vertexCount);
+            const int destination = uniform(vertexCount);
+            if (source != destination) {
+                push(graph, source, destination);
+                ++drawn;
+            }
+        }
+        flush(graph);
+    }
+    lastError_ = GraphError::None;
+    return true;
+}
+
+bool GraphGenerator::barabasiAlbert(Graph& graph, int vertexCount, int edgesPerVertex, bool directed) {
+    if (edgesPerVertex < 1 || vertexCount <= edgesPerVertex) {
+        return fail(GraphError::InvalidGeneratorArguments);
+    }
+
+    graph.configure(vertexCount, directed);
+    // Each edge contributes both endpoints, so a uniform pick from this list is a degree-proportional pick.
+    std::vector<int> endpoints;
+    endpoints.reserve(static_cast<std::size_t>(vertexCount) * edgesPerVertex * 2);
+    std::vector<int> targets;
+    targets.reserve(edgesPerVertex);
+
+    for (int vertex = edgesPerVertex; vertex < vertexCount; ++vertex) {
+        targets.clear();
+        if (endpoints.empty()) {
+            for (int seed = 0; seed < edgesPerVertex; ++seed) {
+                targets.push_back(seed);  // the first newcomer links to every seed vertex
+            }
+        } else {
+            while (static_cast<int>(targets.size()) < edgesPerVertex) {
+                const int candidate = endpoints.at(uniform(static_cast<int>(endpoints.size())));
+                if (std::find(targets.begin(), targets.end(), candidate) == targets.end()) {
+                    targets.push_back(candidate);
+                }
+            }
+        }
+
+        for (int target : targets) {
+            push(graph, vertex, target);
+            endpoints.push_back(vertex);
+            endpoints.push_back(target);
+        }
+    }
+    flush(graph);
+    lastError_ = GraphError::None;
+    return true;
+}
+
+bool GraphGenerator::grid(Graph& graph, int rows, int columns, bool directed) {
+    if (rows < 0 || columns < 0 || static_cast<std::int64_t>(rows) * columns > INT_MAX) {
+        return fail(GraphError::InvalidGeneratorArguments);
+    }
+
+    graph.configure(rows * columns, directed);
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < columns; ++column) {
+            const int vertex = row * columns + column;
+            if (column + 1 < columns) {
+                push(graph, vertex, vertex + 1);
+            }
+            if (row + 1 < rows) {
+                push(graph, vertex, vertex + columns);
+            }
+        }
+    }
+    flush(graph);
+    lastError_ = GraphError::None;
+    return true;
+}
+
+bool GraphGenerator::chain(Graph& graph, int vertexCount, bool directed) {
+    if (vertexCount < 0) {
+        return fail(GraphError::NegativeVertexCount);
+    }
+
+    graph.configure(vertexCount, directed);
+    for (int vertex = 0; vertex + 1 < vertexCount; ++vertex) {
+        push(graph, vertex, vertex + 1);
+    }
+    flush(graph);
+    lastError_ = GraphError::None;
+    return true;
+}
+
+bool GraphGenerator::randomDag(Graph& graph, int vertexCount, std::int64_t edgeCount) {
+    if (vertexCount < 0 || edgeCount < 0 || edgeCount > maxSimpleEdges(vertexCount, false)) {
+        return fail(GraphError::InvalidGeneratorArguments);
+    }
+
+    const std::vector<int> order = randomOrder(vertexCount);
+    graph.configure(vertexCount, true);
+    fillForward(graph, order, edgeCount);
+    lastError_ = GraphError::None;
+    return true;
+}
+
+bool GraphGenerator::dagWithPlantedCycles(Graph& graph, int vertexCount, std::int64_t edgeCount, int cycleCount) {
+    if (cycleCount < 0 || (cycleCount > 0 && vertexCount < kMinPlantedCycle) || edgeCount < 0 ||
+        edgeCount > maxSimpleEdges(vertexCount, false)) {
+        return fail(GraphError::InvalidGeneratorArguments);
+    }
+
+    // Plant the cycles first, so the DAG edges only fill what is left of the edge budget.
+    const std::vector<int> order = randomOrder(vertexCount);
+    graph.configure(vertexCount, true);
+    std::vector<int> cycle;
+    cycle.reserve(kMaxPlantedCycle);
+    for (int planted = 0; planted < cycleCount; ++planted) {
+        const int length = std::min(vertexCount, kMinPlantedCycle + uniform(kMaxPlantedCycle - kMinPlantedCycle + 1));
+        cycle.clear();
+        while (static_cast<int>(cycle.size()) < length) {
+            const int vertex = uniform(vertexCount);
+            if (std::find(cycle.begin(), cycle.end(), vertex) == cycle.end()) {
+                cycle.push_back(vertex);
+            }
+        }
+        // An edge shared with an earlier cycle is dropped as a duplicate, which leaves both cycles intact.
+        for (std::size_t index = 0; index < cycle.size(); ++index) {
+            push(graph, cycle[index], cycle[(index + 1) % cycle.size()]);
+        }
+    }
+    flush(graph);
+    if (graph.edgeCount() > edgeCount) {
+        return fail(GraphError::InvalidGeneratorArguments);  // the budget does not even cover the planted edges
+    }
+
+    fillForward(graph, order, edgeCount);
+    lastError_ = GraphError::None;
+    return true;
+}
+
+GraphError GraphGenerator::getLastError() const {
+    return lastError_;
+}
+
+void GraphGenerator::fillForward(Graph& graph, const std::vector<int>& order, std::int64_t edgeCount) {
+    // Sample pairs of ranks and always point the lower rank at the higher one; the edge index drops repeats.
+    const int vertexCount = static_cast<int>(order.size());
+    while (graph.edgeCount() < edgeCount) {
+        const std::int64_t missing = edgeCount - graph.edgeCount();
+        for (std::int64_t drawn = 0; drawn < missing;) {
+            const int first = uniform(vertexCount);
+            const int second = uniform(vertexCount);
+            if (first != second) {
+                push(graph, order[std::min(first, second)], order[std::max(first, second)]);
+                ++drawn;
+            }
+        }
+        flush(graph);
+    }
+}
+
+void GraphGenerator::push(Graph& graph, int source, int destination) {
+    batch_.push_back({source, destination});
+    if (batch_.size() == kBatchEdges) {
+        flush(graph);
+    }
+}
+
+void GraphGenerator::flush(Graph& graph) {
+    if (batch_.empty()) {
+        return;
+    }
+    graph.addEdges(std::span<const Edge>(batch_.data(), batch_.size()));
+    batch_.clear();
+}
+
+std::vector<int> GraphGenerator::randomOrder(int vertexCount) {
+    std::vector<int> order(vertexCount);
+    for (int vertex = 0; vertex < vertexCount; ++vertex) {
+        order[vertex] = vertex;
+    }
+    for (int index = vertexCount - 1; index > 0; --index) {  // Fisher-Yates by hand, std::shuffle differs across libraries
+        std::swap(order[index], order[uniform(index + 1)]);
+    }
+    return order;
+}
+
+int GraphGenerator::uniform(int bound) {
+    return static_cast<int>(random_() % static_cast<std::uint64_t>(bound));  // modulo bias is negligible for 32-bit bounds
+}
+
+bool GraphGenerator::fail(GraphError error) {
+    lastError_ = error;
+    return false;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Logic/graph_error.h"
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+class Graph;
+
+// GraphGenerator builds reproducible synthetic graphs straight into a Graph.
+// Every generator reconfigures the target graph, streams its edges through Graph::addEdges in batches,
+// and produces the same graph for the same seed and arguments.
+class GraphGenerator {
+public:
+    explicit GraphGenerator(std::uint64_t seed = 0);
+
+    bool erdosRenyi(Graph& graph, int vertexCount, std::int64_t edgeCount, bool directed);  // G(n, m): edgeCount distinct uniform edges, no self-loops
+    bool barabasiAlbert(Graph& graph, int vertexCount, int edgesPerVertex, bool directed);  // preferential attachment; directed edges point new -> old, so acyclic
+    bool grid(Graph& graph, int rows, int columns, bool directed);  // right and down neighbors; directed grids are acyclic
+    bool chain(Graph& graph, int vertexCount, bool directed);  // 0 - 1 - ... - (n-1)
+    bool randomDag(Graph& graph, int vertexCount, std::int64_t edgeCount);  // directed edges that all agree with one random topological order
+    bool dagWithPlantedCycles(Graph& graph, int vertexCount, std::int64_t edgeCount, int cycleCount);  // cycleCount planted cycles of 2-8 random vertices, topped up with DAG edges to exactly edgeCount
+    GraphError getLastError() const;  // reason the last generator failed
+
+private:
+    using Edge = std::pair<int, int>;
+
+    void push(Graph& graph, int source, int destination);  // buffer one edge, flushing full batches into graph
+    void flush(Graph& graph);  // hand buffered edges to graph
+    void fillForward(Graph& graph, const std::vector<int>& order, std::int64_t edgeCount);  // add edges that agree with order until graph has edgeCount
+    std::vector<int> randomOrder(int vertexCount);  // uniformly shuffled 0..vertexCount-1
+    int uniform(int bound);  // uniform integer in [0, bound)
+    bool fail(GraphError error);  // record error and return false
+
+    std::mt19937_64 random_;  // the single source of randomness, seeded once
+    std::vector<Edge> batch_;  // edges waiting for the next addEdges call
+    GraphError lastError_{GraphError::None};  // reason the last generator failed
+};
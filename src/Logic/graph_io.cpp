@@ -0,0 +1,276 @@
+#include "Logic/graph_io.h"
+#include "Logic/file_util.h"
+#include "Logic/graph.h"
+#include "Logic/perf_counters.h"
+
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace {
+constexpr std::size_t kChunkBytes = 1 << 20;  // bytes pulled from disk per fread
+constexpr std::size_t kBatchEdges = 1 << 16;  // edges handed to Graph::addEdges at a time
+
+// Calls handle(begin, end) for every line of the file, reading it one chunk at a time.
+// A line longer than the buffer grows the buffer; handle returns false to stop early.
+template <typename LineHandler>
+bool forEachLine(const std::filesystem::path& path, LineHandler&& handle, GraphError& error) {
+    std::FILE* file = openFile(path, "rb");
+    if (!file) {
+        error = GraphError::OpenFailed;
+        return false;
+    }
+
+    std::vector<char> buffer(kChunkBytes);
+    std::size_t carried = 0;  // bytes of an unfinished line kept at the front of the buffer
+    bool keepGoing = true;
+    while (keepGoing) {
+        if (carried == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+
+        const size_t read = std::fread(buffer.data() + carried, 1, static_cast<size_t>(buffer.size() - carried), file);
+        const char* lineStart = buffer.data();
+        const char* end = lineStart + carried + static_cast<std::size_t>(read);
+        if (read == 0) {
+            if (lineStart != end) {
+                handle(lineStart, (end[-1] == '\r') ? end - 1 : end);  // last line without a trailing newline
+            }
+            break;
+        }
+
+        while (keepGoing) {
+            const char* newline = static_cast<const char*>(std::memchr(lineStart, '\n', static_cast<size_t>(end - lineStart)));
+            if (!newline) {
+                break;
+            }
+            const char* lineEnd = (newline > lineStart && newline[-1] == '\r') ? newline - 1 : newline;
+            keepGoing = handle(lineStart, lineEnd);
+            lineStart = newline + 1;
+        }
+
+        carried = end - lineStart;
+        std::memmove(buffer.data(), lineStart, static_cast<size_t>(carried));
+    }
+
+    const bool failed = std::ferror(file) != 0;
+    std::fclose(file);
+    if (failed) {
+        error = GraphError::ReadFailed;
+        return false;
+    }
+    return true;
+}
+
+const char* skipBlanks(const char* cursor, const char* end) {
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t')) {
+        ++cursor;
+    }
+    return cursor;
+}
+
+// Parses one non-negative integer after optional blanks, advancing cursor past it.
+bool parseId(const char*& cursor, const char* end, std::int64_t& value) {
+    cursor = skipBlanks(cursor, end);
+    const auto [next, status] = std::from_chars(cursor, end, value);
+    if (status != std::errc() || value < 0) {
+        return false;
+    }
+    cursor = next;
+    return true;
+}
+
+bool isCommentOrBlank(const char* begin, const char* end) {
+    const char* first = skipBlanks(begin, end);
+    return first == end || *first == '#' || *first == '%';
+}
+}
+
+GraphImporter::GraphImporter(Format format)
+    : format_(format) {
+}
+
+void GraphImporter::setSizeLimit(int maxVertices, std::int64_t maxEdgeLines) {
+    maxVertices_ = maxVertices;
+    maxEdgeLines_ = maxEdgeLines;
+}
+
+bool GraphImporter::load(const std::filesystem::path& path, bool isDirected, Graph& graph) {
+    ScopedPerfTimer timer(PerfOp::LoadGraph);
+    edgesAdded_ = 0;
+    linesSkipped_ = 0;
+    lastError_ = GraphError::None;
+
+    Format format = format_;
+    if (format == Format::Auto) {
+        format = detectFormat(path);
+        if (lastError_ != GraphError::None) {
+            return false;
+        }
+    }
+
+    return format == Format::Dimacs ? loadDimacs(path, isDirected, graph) : loadEdgeList(path, isDirected, graph);
+}
+
+GraphImporter::Format GraphImporter::detectFormat(const std::filesystem::path& path) {
+    Format detected = Format::EdgeList;
+    forEachLine(path, [&detected](const char* begin, const char* end) {
+        const char* first = skipBlanks(begin, end);
+        if (first == end) {
+            return true;  // keep looking past blank lines
+        }
+        if (*first == 'p' || *first == 'c') {
+            detected = Format::Dimacs;
+        }
+        return false;
+    }, lastError_);
+    return detected;
+}
+
+bool GraphImporter::loadEdgeList(const std::filesystem::path& path, bool isDirected, Graph& graph) {
+    // First pass: the largest id decides the vertex count, so nothing but one integer is kept. It also stops
+    // early once the file has more edge lines than the size limit allows.
+    std::int64_t maxId = -1;
+    std::int64_t edgeLines = 0;
+    const bool scanned = forEachLine(path, [&](const char* begin, const char* end) {
+        if (isCommentOrBlank(begin, end)) {
+            return true;
+        }
+        std::int64_t source = 0;
+        std::int64_t target = 0;
+        const char* cursor = begin;
+        if (parseId(cursor, end, source) && parseId(cursor, end, target)) {
+            maxId = std::max(maxId, std::max(source, target));
+            if (++edgeLines > maxEdgeLines_) {
+                lastError_ = GraphError::GraphTooLarge;
+                return false;
+            }
+        }
+        return true;
+    }, lastError_);
+    if (!scanned || lastError_ != GraphError::None) {
+        return false;
+    }
+    if (maxId >= INT_MAX) {
+        lastError_ = GraphError::VertexIdTooLarge;
+        return false;
+    }
+    if (maxId + 1 > maxVertices_) {
+        lastError_ = GraphError::GraphTooLarge;
+        return false;
+    }
+
+    graph.configure(static_cast<int>(maxId + 1), isDirected);
+
+    // Second pass: stream the pairs into the graph in fixed-size batches.
+    std::vector<std::pair<int, int>> batch;
+    batch.reserve(kBatchEdges);
+    const auto flush = [&]() {
+        const int added = graph.addEdges(std::span<const std::pair<int, int>>(batch.data(), batch.size()));
+        edgesAdded_ += added;
+        linesSkipped_ += batch.size() - added;
+        batch.clear();
+    };
+
+    const bool loaded = forEachLine(path, [&](const char* begin, const char* end) {
+        if (isCommentOrBlank(begin, end)) {
+            return true;
+        }
+        std::int64_t source = 0;
+        std::int64_t target = 0;
+        const char* cursor = begin;
+        if (!parseId(cursor, end, source) || !parseId(cursor, end, target)) {
+            ++linesSkipped_;
+            return true;
+        }
+        batch.push_back({static_cast<int>(source), static_cast<int>(target)});
+        if (batch.size() == kBatchEdges) {
+            flush();
+        }
+        return true;
+    }, lastError_);
+    flush();
+    return loaded;
+}
+
+bool GraphImporter::loadDimacs(const std::filesystem::path& path, bool isDirected, Graph& graph) {
+    bool sized = false;
+    std::int64_t edgeLines = 0;
+    std::vector<std::pair<int, int>> batch;
+    batch.reserve(kBatchEdges);
+    const auto flush = [&]() {
+        const int added = graph.addEdges(std::span<const std::pair<int, int>>(batch.data(), batch.size()));
+        edgesAdded_ += added;
+        linesSkipped_ += batch.size() - added;
+        batch.clear();
+    };
+
+    const bool loaded = forEachLine(path, [&](const char* begin, const char* end) {
+        const char* cursor = skipBlanks(begin, end);
+        if (cursor == end || *cursor == 'c') {
+            return true;
+        }
+
+        const char kind = *cursor++;
+        if (kind == 'p') {
+            // "p <problem> <vertices> <edges>": skip the problem name, keep the vertex count.
+            cursor = skipBlanks(cursor, end);
+            while (cursor < end && *cursor != ' ' && *cursor != '\t') {
+                ++cursor;
+            }
+            std::int64_t vertices = 0;
+            if (sized || !parseId(cursor, end, vertices) || vertices >= INT_MAX) {
+                lastError_ = GraphError::InvalidProblemLine;
+                return false;
+            }
+            if (vertices > maxVertices_) {
+                lastError_ = GraphError::GraphTooLarge;
+                return false;
+            }
+            graph.configure(static_cast<int>(vertices), isDirected);
+            sized = true;
+            return true;
+        }
+
+        if ((kind == 'e' || kind == 'a') && ++edgeLines > maxEdgeLines_) {
+            lastError_ = GraphError::GraphTooLarge;
+            return false;
+        }
+
+        std::int64_t source = 0;
+        std::int64_t target = 0;
+        if ((kind != 'e' && kind != 'a') || !sized || !parseId(cursor, end, source) || !parseId(cursor, end, target) ||
+            source == 0 || target == 0 || source > INT_MAX || target > INT_MAX) {
+            ++linesSkipped_;
+            return true;
+        }
+        batch.push_back({static_cast<int>(source - 1), static_cast<int>(target - 1)});  // DIMACS ids are 1-based
+        if (batch.size() == kBatchEdges) {
+            flush();
+        }
+        return true;
+    }, lastError_);
+    flush();
+
+    if (loaded && lastError_ == GraphError::None && !sized) {
+        lastError_ = GraphError::MissingProblemLine;
+    }
+    return loaded && lastError_ == GraphError::None;
+}
+
+std::int64_t GraphImporter::edgesAdded() const {
+    return edgesAdded_;
+}
+
+std::int64_t GraphImporter::linesSkipped() const {
+    return linesSkipped_;
+}
+
+GraphError GraphImporter::getLastError() const {
+    return lastError_;
+}
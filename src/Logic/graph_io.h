@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Logic/graph_error.h"
+
+#include <climits>
+#include <cstdint>
+#include <filesystem>
+
+class Graph;
+
+// GraphImporter streams edge lists into a Graph in fixed-size chunks, so multi-GB files never sit in memory as text.
+// Supported layouts:
+//   EdgeList - one "source target" pair per line, 0-based ids, '#' or '%' comments (this also covers SNAP dumps)
+//   Dimacs   - "p <kind> <vertices> <edges>" problem line followed by "e u v" or "a u v [weight]" lines, 1-based ids
+class GraphImporter {
+public:
+    enum class Format {
+        Auto,  // Dimacs when the first meaningful line starts with 'p' or 'c', EdgeList otherwise
+        EdgeList,
+        Dimacs
+    };
+
+    explicit GraphImporter(Format format = Format::Auto);
+
+    // Reject files with more vertices or edge lines than given, with GraphTooLarge, as soon as the limit is crossed,
+    // so a caller that can only use small graphs does not stream a huge file first. Unlimited by default.
+    void setSizeLimit(int maxVertices, std::int64_t maxEdgeLines);
+    bool load(const std::filesystem::path& path, bool isDirected, Graph& graph);  // replace graph's contents with the file's edges
+    std::int64_t edgesAdded() const;  // edges stored by the last load()
+    std::int64_t linesSkipped() const;  // malformed, out-of-range or duplicate edge lines ignored by the last load()
+    GraphError getLastError() const;  // reason the last load() failed
+
+private:
+    bool loadEdgeList(const std::filesystem::path& path, bool isDirected, Graph& graph);  // max-id pre-scan, then a streaming insert pass
+    bool loadDimacs(const std::filesystem::path& path, bool isDirected, Graph& graph);  // single pass sized by the problem line
+    Format detectFormat(const std::filesystem::path& path);  // peek at the first meaningful line
+
+    Format format_;  // requested layout
+    int maxVertices_{INT_MAX};  // setSizeLimit() vertex bound
+    std::int64_t maxEdgeLines_{INT64_MAX};  // setSizeLimit() bound on edge lines, counted before duplicates are dropped
+    std::int64_t edgesAdded_{0};  // edges stored by the last load()
+    std::int64_t linesSkipped_{0};  // lines ignored by the last load()
+    GraphError lastError_{GraphError::None};  // reason the last load() failed
+};
@@ -0,0 +1,298 @@
+#include "Logic/graph_snapshot.h"
+#include "Logic/file_util.h"
+#include "Logic/graph.h"
+#include "Logic/perf_counters.h"
+
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr char kMagic[8] = {'N', 'C', 'E', 'S', 'N', 'A', 'P', '\0'};
+constexpr std::uint32_t kByteOrderMark = 0x01020304;  // reads back differently on a host with the other endianness
+constexpr std::uint32_t kDirectedFlag = 1u << 0;
+constexpr std::size_t kWriteBatch = 1 << 16;  // array elements buffered per fwrite
+
+struct SnapshotHeader {
+    char magic[8];  // kMagic
+    std::uint32_t version;  // GraphSnapshot::kVersion
+    std::uint32_t byteOrder;  // kByteOrderMark as written by the saving host
+    std::uint32_t flags;  // kDirectedFlag
+    std::int32_t vertexCount;  // number of vertices
+    std::int64_t targetCount;  // number of entries in the targets array
+    std::uint64_t checksum;  // hashStep() folded over every offset, then every target
+    std::uint64_t offsetsAt;  // byte position of the offsets array
+    std::uint64_t targetsAt;  // byte position of the targets array
+    std::uint64_t reserved;  // zero; room for a future field without moving the arrays
+};
+static_assert(sizeof(SnapshotHeader) == 64, "snapshot header must stay 64 bytes");
+
+// FNV-1a step applied per array element rather than per byte, so hashing keeps up with the disk.
+std::uint64_t hashStep(std::uint64_t hash, std::uint64_t value) {
+    return (hash ^ value) * 0x100000001b3ULL;
+}
+constexpr std::uint64_t kHashSeed = 0xcbf29ce484222325ULL;
+
+std::uint64_t alignUp(std::uint64_t value) {
+    return (value + 7) & ~std::uint64_t(7);
+}
+
+// Read-only file mapping that unmaps itself; shared with Graph as the owner of the adopted arrays.
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data_) {
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_) {
+            CloseHandle(mapping_);
+        }
+        if (file_ != INVALID_HANDLE_VALUE) {
+            CloseHandle(file_);
+        }
+#else
+        if (data_) {
+            munmap(const_cast<char*>(data_), static_cast<size_t>(size_));
+        }
+#endif
+    }
+
+    bool open(const std::filesystem::path& path, GraphError& error) {
+#ifdef _WIN32
+        file_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+        LARGE_INTEGER size;
+        if (file_ == INVALID_HANDLE_VALUE || !GetFileSizeEx(file_, &size)) {
+            error = GraphError::OpenFailed;
+            return false;
+        }
+        size_ = size.QuadPart;
+        if (size_ < static_cast<std::int64_t>(sizeof(SnapshotHeader))) {
+            error = GraphError::NotASnapshot;
+            return false;
+        }
+        mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        data_ = mapping_ ? static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+#else
+        const int descriptor = ::open(path.c_str(), O_RDONLY);
+        struct stat status;
+        if (descriptor < 0 || fstat(descriptor, &status) != 0) {
+            if (descriptor >= 0) {
+                ::close(descriptor);
+            }
+            error = GraphError::OpenFailed;
+            return false;
+        }
+        size_ = status.st_size;
+        if (size_ < static_cast<std::int64_t>(sizeof(SnapshotHeader))) {
+            ::close(descriptor);
+            error = GraphError::NotASnapshot;
+            return false;
+        }
+        void* mapped = mmap(nullptr, static_cast<size_t>(size_), PROT_READ, MAP_PRIVATE, descriptor, 0);
+        ::close(descriptor);  // the mapping keeps its own reference to the file
+        data_ = (mapped == MAP_FAILED) ? nullptr : static_cast<const char*>(mapped);
+#endif
+        if (!data_) {
+            error = GraphError::MapFailed;
+            return false;
+        }
+        return true;
+    }
+
+    const char* data() const { return data_; }
+    std::int64_t size() const { return size_; }
+
+private:
+#ifdef _WIN32
+    HANDLE file_{INVALID_HANDLE_VALUE};
+    HANDLE mapping_{nullptr};
+#endif
+    const char* data_{nullptr};  // start of the read-only view
+    std::int64_t size_{0};  // bytes in the view
+};
+
+// Buffers one array and streams it to file while folding it into the checksum.
+template <typename T>
+class ArrayWriter {
+public:
+    ArrayWriter(std::FILE* file, std::uint64_t& checksum) : file_(file), checksum_(checksum) { buffer_.reserve(kWriteBatch); }
+
+    void append(T value) {
+        checksum_ = hashStep(checksum_, static_cast<std::uint64_t>(value));
+        buffer_.push_back(value);
+        if (buffer_.size() == kWriteBatch) {
+            flush();
+        }
+    }
+
+    bool flush() {
+        const size_t count = static_cast<size_t>(buffer_.size());
+        ok_ = ok_ && std::fwrite(buffer_.data(), sizeof(T), count, file_) == count;
+        buffer_.clear();
+        return ok_;
+    }
+
+private:
+    std::FILE* file_;
+    std::uint64_t& checksum_;
+    std::vector<T> buffer_;
+    bool ok_{true};
+};
+}
+
+bool GraphSnapshot::probe(const std::filesystem::path& path) {
+    std::FILE* file = openFile(path, "rb");
+    if (!file) {
+        return false;
+    }
+    char magic[sizeof(kMagic)] = {};
+    const bool matches = std::fread(magic, 1, sizeof(magic), file) == sizeof(magic) && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+    std::fclose(file);
+    return matches;
+}
+
+bool GraphSnapshot::save(const Graph& graph, const std::filesystem::path& path) {
+    lastError_ = GraphError::None;
+    std::FILE* file = openFile(path, "wb");
+    if (!file) {
+        lastError_ = GraphError::OpenFailed;
+        return false;
+    }
+
+    const int vertexCount = graph.vertexCount();
+    SnapshotHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.byteOrder = kByteOrderMark;
+    header.flags = graph.isDirected() ? kDirectedFlag : 0;
+    header.vertexCount = vertexCount;
+    header.offsetsAt = sizeof(SnapshotHeader);
+    header.targetsAt = alignUp(header.offsetsAt + static_cast<std::uint64_t>(vertexCount + 1) * sizeof(std::int64_t));
+
+    // Placeholder header; the checksum and target count are only known once the arrays are written.
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+
+    std::uint64_t checksum = kHashSeed;
+    ArrayWriter<std::int64_t> offsets(file, checksum);
+    std::int64_t running = 0;
+    offsets.append(running);
+    for (int vertex = 0; vertex < vertexCount; ++vertex) {
+        running += graph.degree(vertex);
+        offsets.append(running);
+    }
+    ok = ok && offsets.flush();
+
+    ArrayWriter<int> targets(file, checksum);
+    for (int vertex = 0; vertex < vertexCount; ++vertex) {
+        for (int neighbor : graph.neighbors(vertex)) {
+            targets.append(neighbor);
+        }
+    }
+    ok = ok && targets.flush();
+
+    header.targetCount = running;
+    header.checksum = checksum;
+    ok = ok && std::fseek(file, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        lastError_ = GraphError::WriteFailed;
+        return false;
+    }
+    return true;
+}
+
+bool GraphSnapshot::load(const std::filesystem::path& path, Graph& graph, bool verify) {
+    ScopedPerfTimer timer(PerfOp::LoadGraph);
+    lastError_ = GraphError::None;
+    auto mapping = std::make_shared<MappedFile>();
+    if (!mapping->open(path, lastError_)) {
+        return false;
+    }
+
+    SnapshotHeader header;
+    std::memcpy(&header, mapping->data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        lastError_ = GraphError::NotASnapshot;
+        return false;
+    }
+    if (header.version != kVersion || header.byteOrder != kByteOrderMark) {
+        lastError_ = GraphError::IncompatibleSnapshot;
+        return false;
+    }
+
+    // Bounds-check the arrays against the file before any pointer into the mapping is formed.
+    if (header.vertexCount < 0 || header.vertexCount == INT_MAX || header.targetCount < 0) {
+        lastError_ = GraphError::CorruptSnapshot;
+        return false;
+    }
+    const std::uint64_t fileSize = static_cast<std::uint64_t>(mapping->size());
+    const std::uint64_t offsetsBytes = (static_cast<std::uint64_t>(header.vertexCount) + 1) * sizeof(std::int64_t);
+    const std::uint64_t targetsBytes = static_cast<std::uint64_t>(header.targetCount) * sizeof(int);
+    if (header.offsetsAt % 8 != 0 || header.targetsAt % 8 != 0 ||
+        header.offsetsAt < sizeof(header) || header.offsetsAt + offsetsBytes > fileSize ||
+        header.targetsAt < header.offsetsAt + offsetsBytes || header.targetsAt + targetsBytes > fileSize) {
+        lastError_ = GraphError::CorruptSnapshot;
+        return false;
+    }
+
+    const auto* offsets = reinterpret_cast<const std::int64_t*>(mapping->data() + header.offsetsAt);
+    const auto* targets = reinterpret_cast<const int*>(mapping->data() + header.targetsAt);
+    if (offsets[0] != 0 || offsets[header.vertexCount] != header.targetCount) {
+        lastError_ = GraphError::CorruptSnapshot;
+        return false;
+    }
+
+    // Verification is one pass over both arrays: offsets must never decrease, every target must be a vertex,
+    // and the checksum must match. The traversals index straight into these arrays, so an unverified file is
+    // trusted to be well formed; skipping the pass is what keeps opening a huge snapshot O(1).
+    if (verify) {
+        bool valid = true;
+        std::uint64_t checksum = hashStep(kHashSeed, static_cast<std::uint64_t>(offsets[0]));
+        for (std::int64_t vertex = 1; vertex <= header.vertexCount; ++vertex) {
+            valid = valid && offsets[vertex] >= offsets[vertex - 1];
+            checksum = hashStep(checksum, static_cast<std::uint64_t>(offsets[vertex]));
+        }
+        for (std::int64_t slot = 0; slot < header.targetCount; ++slot) {
+            valid = valid && targets[slot] >= 0 && targets[slot] < header.vertexCount;
+            checksum = hashStep(checksum, static_cast<std::uint64_t>(targets[slot]));
+        }
+        if (!valid) {
+            lastError_ = GraphError::CorruptSnapshot;
+            return false;
+        }
+        if (checksum != header.checksum) {
+            lastError_ = GraphError::ChecksumMismatch;
+            return false;
+        }
+    }
+
+    if (!graph.adoptCsr(header.vertexCount, (header.flags & kDirectedFlag) != 0, offsets, targets, std::move(mapping))) {
+        lastError_ = graph.getLastError();
+        return false;
+    }
+    return true;
+}
+
+GraphError GraphSnapshot::getLastError() const {
+    return lastError_;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Logic/graph_error.h"
+
+#include <cstdint>
+#include <filesystem>
+
+class Graph;
+
+// GraphSnapshot writes a Graph as one binary CSR image and maps it back without parsing.
+// File layout (host byte order, every array 8-byte aligned):
+//   Header   - 64 bytes, see SnapshotHeader in graph_snapshot.cpp
+//   offsets  - std::int64_t[vertexCount + 1]
+//   targets  - int[targetCount]
+// Loading maps the file read-only, checks the header against the file size, and hands the arrays to
+// Graph::adoptCsr without copying them, so opening costs O(1) however large the graph is; pages are read as the
+// traversals reach them. load(..., verify = true) first makes one O(V+E) pass over the arrays, checking that
+// offsets never decrease, that every target is a valid vertex and that the checksum matches. Skip it only for
+// files this program wrote: an unverified corrupt file can send a traversal outside the mapping.
+// Edits afterwards thaw the graph into its own linked lists and release the mapping.
+class GraphSnapshot {
+public:
+    static constexpr std::uint32_t kVersion = 1;  // bumped whenever the layout changes
+
+    static bool probe(const std::filesystem::path& path);  // true when path starts with the snapshot magic
+    bool save(const Graph& graph, const std::filesystem::path& path);  // write graph's edges; works whether or not it is frozen
+    bool load(const std::filesystem::path& path, Graph& graph, bool verify = false);  // map path into graph; verify checks structure and checksum first in one O(V+E) pass
+    GraphError getLastError() const;  // reason the last save() or load() failed
+
+private:
+    GraphError lastError_{GraphError::None};  // reason the last save() or load() failed
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Logic/perf_counters.h"
+
+// NodePool hands out fixed-size nodes from contiguous blocks so adjacency lists avoid one heap call per edge.
+// Node must expose a `Node* next` member; released nodes are threaded through it as a free list.
+template <typename Node>
+class NodePool {
+public:
+    explicit NodePool(int blockSize = 4096) : blockSize_(blockSize > 0 ? blockSize : 1) {}
+    ~NodePool() { clear(); }
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    Node* allocate() {
+        if (freeList_) {  // recycle nodes handed back by release()
+            Node* node = freeList_;
+            freeList_ = node->next;
+            return node;
+        }
+
+        if (currentBlock_ < 0 || nextSlot_ == blockSize_) {
+            ++currentBlock_;
+            if (currentBlock_ == static_cast<int>(blocks_.size())) {
+                addBlock();
+            }
+            nextSlot_ = 0;
+        }
+        return &blocks_[currentBlock_][nextSlot_++];
+    }
+
+    void reserve(std::int64_t count) {  // pre-allocate blocks so the next count allocations never hit the heap
+        std::int64_t available = (currentBlock_ < 0 ? 0 : blockSize_ - nextSlot_) +
+                                 (static_cast<std::int64_t>(blocks_.size()) - currentBlock_ - 1) * blockSize_;
+        while (available < count) {
+            addBlock();
+            available += blockSize_;
+        }
+    }
+
+    void release(Node* node) {
+        node->next = freeList_;
+        freeList_ = node;
+    }
+
+    // Forget every live node. Up to kRetainedBlocks blocks stay for reuse, so clearing and refilling a small graph
+    // never touches the heap; the rest go back, so a cleared large graph does not pin its peak memory.
+    void reset() {
+        releaseBlocksFrom(kRetainedBlocks);
+        currentBlock_ = -1;
+        nextSlot_ = blockSize_;
+        freeList_ = nullptr;
+    }
+
+    void clear() {  // return all blocks to the heap, O(number of blocks)
+        releaseBlocksFrom(0);
+        reset();
+    }
+
+    std::int64_t reservedBytes() const { return static_cast<std::int64_t>(blocks_.size()) * blockSize_ * sizeof(Node); }
+
+    static constexpr std::size_t kRetainedBlocks = 16;  // blocks reset() keeps, 64K nodes at the default block size
+
+private:
+    void releaseBlocksFrom(std::size_t first) {  // free blocks [first, end)
+        if (blocks_.size() <= first) {
+            return;
+        }
+        for (std::size_t index = first; index < blocks_.size(); ++index) {
+            delete[] blocks_[index];
+        }
+        PerfCounters::instance().trackAdjacencyBytes(-static_cast<std::int64_t>(blocks_.size() - first) * blockSize_ *
+                                                     static_cast<std::int64_t>(sizeof(Node)));
+        blocks_.resize(first);
+    }
+
+    void addBlock() {
+        blocks_.push_back(new Node[blockSize_]);
+        PerfCounters::instance().trackAdjacencyBytes(static_cast<std::int64_t>(blockSize_) * sizeof(Node));
+    }
+
+    std::vector<Node*> blocks_;  // each block holds blockSize_ nodes
+    int blockSize_;  // nodes per block
+    int currentBlock_{-1};  // block currently being carved, -1 before the first allocation
+    int nextSlot_{0};  // next unused slot in the current block
+    Node* freeList_{nullptr};  // singly linked list of released nodes
+};
@@ -0,0 +1,169 @@
+#include "Logic/parallel_cycle_detector.h"
+#include "Logic/concurrent_disjoint_set.h"
+#include "Logic/graph.h"
+#include "Logic/parallel_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr std::int64_t kVertexGrain = 1 << 14;  // vertices per chunk in the whole-graph passes
+    constexpr std::int64_t kFrontierGrain = 1 << 10;  // frontier vertices per chunk in a trimming round
+    constexpr std::size_t kParallelFrontier = 1 << 13;  // narrower frontiers are trimmed on the calling thread
+    constexpr std::int64_t kEdgeGrain = 1 << 16;  // CSR slots per chunk in the undirected scan
+    constexpr std::int64_t kListGrain = 1 << 10;  // vertices per chunk when the graph is not frozen
+}
+
+ParallelCycleDetector::ParallelCycleDetector(int threadCount)
+    : threadCount_(threadCount > 0 ? threadCount : static_cast<int>(std::thread::hardware_concurrency())) {
+    if (threadCount_ < 1) {
+        threadCount_ = 1;
+    }
+}
+
+int ParallelCycleDetector::threadCount() const {
+    return threadCount_;
+}
+
+bool ParallelCycleDetector::hasDirectedCycle(const Graph& graph) const {
+    const int vertexCount = graph.vertexCount();
+    if (vertexCount <= 0) {
+        return false;
+    }
+
+    ParallelPool& pool = ParallelPool::shared();
+    const int workers = std::min(threadCount_, pool.threadCount());
+    if (workers == 1) {
+        return !graph.cycleWitness().isEmpty();  // one pass of the serial DFS beats two passes of trimming
+    }
+
+    std::unique_ptr<std::atomic<int>[]> inDegree(new std::atomic<int>[vertexCount]);
+    pool.forEachChunk(workers, vertexCount, kVertexGrain, [&](int, std::int64_t first, std::int64_t last) {
+        for (std::int64_t vertex = first; vertex < last; ++vertex) {
+            inDegree[vertex].store(0, std::memory_order_relaxed);
+        }
+    });
+    pool.forEachChunk(workers, vertexCount, kVertexGrain, [&](int, std::int64_t first, std::int64_t last) {
+        for (std::int64_t vertex = first; vertex < last; ++vertex) {
+            for (int neighbor : graph.neighbors(static_cast<int>(vertex))) {
+                inDegree[neighbor].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    // Trim level by level from one shared frontier. Each round hands out frontier chunks dynamically, so a
+    // worker that draws high-degree vertices does not hold back the rest; whoever drops a vertex to zero
+    // queues it for the next round, which makes every vertex enter the frontier exactly once.
+    std::vector<std::vector<int>> next(workers);
+    pool.forEachChunk(workers, vertexCount, kVertexGrain, [&](int worker, std::int64_t first, std::int64_t last) {
+        for (std::int64_t vertex = first; vertex < last; ++vertex) {
+            if (inDegree[vertex].load(std::memory_order_relaxed) == 0) {
+                next[worker].push_back(static_cast<int>(vertex));
+            }
+        }
+    });
+
+    std::vector<int> frontier;
+    std::int64_t trimmed = 0;
+    auto gather = [&] {
+        frontier.clear();
+        for (std::vector<int>& buffer : next) {
+            frontier.insert(frontier.end(), buffer.begin(), buffer.end());
+            buffer.clear();
+        }
+    };
+    gather();
+
+    while (!frontier.empty()) {
+        trimmed += static_cast<std::int64_t>(frontier.size());
+        if (frontier.size() < kParallelFrontier) {
+            // Narrow levels (long chains, the tail of most DAGs) are cheaper on one thread than a wake-up each.
+            for (int vertex : frontier) {
+                for (int neighbor : graph.neighbors(vertex)) {
+                    if (inDegree[neighbor].fetch_sub(1, std::memory_order_relaxed) == 1) {
+                        next[0].push_back(neighbor);
+                    }
+                }
+            }
+        } else {
+            pool.forEachChunk(workers, static_cast<std::int64_t>(frontier.size()), kFrontierGrain,
+                              [&](int worker, std::int64_t first, std::int64_t last) {
+                                  std::vector<int>& queued = next[worker];
+                                  for (std::int64_t slot = first; slot < last; ++slot) {
+                                      for (int neighbor : graph.neighbors(frontier[slot])) {
+                                          if (inDegree[neighbor].fetch_sub(1, std::memory_order_relaxed) == 1) {
+                                              queued.push_back(neighbor);
+                                          }
+                                      }
+                                  }
+                              });
+        }
+        gather();
+    }
+
+    return trimmed < vertexCount;
+}
+
+bool ParallelCycleDetector::hasUndirectedCycle(const Graph& graph) const {
+    const int vertexCount = graph.vertexCount();
+    if (vertexCount <= 0) {
+        return false;
+    }
+
+    ParallelPool& pool = ParallelPool::shared();
+    const int workers = std::min(threadCount_, pool.threadCount());
+    ConcurrentDisjointSet set(vertexCount);
+    std::atomic<bool> found{false};
+
+    // Feed one stored edge to the union-find; true once any worker has seen a cycle.
+    auto visit = [&](int vertex, int neighbor) {
+        if (vertex > neighbor) {
+            return false;  // process each undirected edge once
+        }
+        if (vertex == neighbor || !set.unite(vertex, neighbor)) {
+            found.store(true, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    };
+
+    const std::int64_t* offsets = graph.csrOffsets();
+    const int* targets = graph.csrTargets();
+    if (offsets) {
+        // Frozen graphs are split by edge slots rather than by vertex, so a hub's adjacency is shared out
+        // instead of landing on one worker. Each chunk finds its first source with a binary search.
+        pool.forEachChunk(workers, offsets[vertexCount], kEdgeGrain, [&](int, std::int64_t first, std::int64_t last) {
+            if (found.load(std::memory_order_relaxed)) {
+                return;  // another worker already answered
+            }
+            int vertex = static_cast<int>(std::upper_bound(offsets, offsets + vertexCount + 1, first) - offsets) - 1;
+            for (std::int64_t slot = first; slot < last; ++slot) {
+                while (slot >= offsets[vertex + 1]) {
+                    ++vertex;
+                }
+                if (visit(vertex, targets[slot])) {
+                    return;
+                }
+            }
+        });
+        return found.load();
+    }
+
+    pool.forEachChunk(workers, vertexCount, kListGrain, [&](int, std::int64_t first, std::int64_t last) {
+        for (int vertex = static_cast<int>(first); vertex < last; ++vertex) {
+            if (found.load(std::memory_order_relaxed)) {
+                return;
+            }
+            for (int neighbor : graph.neighbors(vertex)) {
+                if (visit(vertex, neighbor)) {
+                    return;
+                }
+            }
+        }
+    });
+    return found.load();
+}
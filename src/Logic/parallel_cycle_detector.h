@@ -0,0 +1,25 @@
+#pragma once
+
+class Graph;
+
+// ParallelCycleDetector checks a graph for cycles using several threads at once.
+class ParallelCycleDetector {
+public:
+    explicit ParallelCycleDetector(int threadCount = 0);  // 0 picks one thread per hardware core
+
+    // Directed check by parallel trimming: vertices whose remaining in-degree reaches zero are peeled off
+    // level by level from a shared frontier until nothing changes. Every survivor keeps a surviving
+    // predecessor, so survivors exist exactly when the graph has a cycle; the check needs no SCC split.
+    // With a single worker available the graph's serial DFS answers instead.
+    bool hasDirectedCycle(const Graph& graph) const;
+
+    // Undirected check: edges are fed to a shared lock-free union-find in chunks of CSR slots (of vertices
+    // when the graph is not frozen).
+    // The first worker that finds an edge whose endpoints are already connected stops everyone.
+    bool hasUndirectedCycle(const Graph& graph) const;
+
+    int threadCount() const;  // number of worker threads a run will use
+
+private:
+    int threadCount_;  // resolved worker count, always at least one
+};
@@ -0,0 +1,78 @@
+#include "Logic/parallel_pool.h"
+
+ParallelPool& ParallelPool::shared() {
+    static ParallelPool pool(static_cast<int>(std::thread::hardware_concurrency()));
+    return pool;
+}
+
+ParallelPool::ParallelPool(int threadCount) {
+    for (int participant = 1; participant < threadCount; ++participant) {
+        threads_.emplace_back([this, participant] { work(participant); });
+    }
+}
+
+ParallelPool::~ParallelPool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& thread : threads_) {
+        thread.join();
+    }
+}
+
+int ParallelPool::threadCount() const {
+    return static_cast<int>(threads_.size()) + 1;
+}
+
+void ParallelPool::run(int participants, const std::function<void(int)>& body) {
+    std::unique_lock<std::mutex> job(jobMutex_, std::try_to_lock);
+    if (participants > threadCount()) {
+        participants = threadCount();
+    }
+    if (!job.owns_lock() || participants <= 1) {
+        body(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        body_ = &body;
+        participants_ = participants;
+        remaining_ = participants - 1;
+        ++generation_;
+    }
+    wake_.notify_all();
+    body(0);
+
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    finished_.wait(lock, [this] { return remaining_ == 0; });
+    body_ = nullptr;
+}
+
+void ParallelPool::work(int participant) {
+    std::uint64_t seen = 0;
+    while (true) {
+        const std::function<void(int)>* body = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(stateMutex_);
+            wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_) {
+                return;
+            }
+            seen = generation_;
+            if (participant >= participants_) {
+                continue;  // this job asked for fewer threads
+            }
+            body = body_;
+        }
+
+        (*body)(participant);
+
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        if (--remaining_ == 0) {
+            finished_.notify_one();
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ParallelPool is the process-wide team behind the parallel detectors. Its threads start on first use and sleep
+// between jobs, so each phase of a detector costs one wake-up instead of creating and joining threads.
+// One job runs at a time; a caller that finds the team busy (say, several CLI workers at once) runs its job
+// alone on its own thread instead of waiting.
+class ParallelPool {
+public:
+    static ParallelPool& shared();
+    ~ParallelPool();  // wakes and joins the workers
+
+    ParallelPool(const ParallelPool&) = delete;
+    ParallelPool& operator=(const ParallelPool&) = delete;
+
+    int threadCount() const;  // workers plus the calling thread
+    void run(int participants, const std::function<void(int participant)>& body);  // body(0) on the caller, body(1..) on workers; returns when all finish
+
+    // Split [0, count) into grain-sized chunks handed out through a shared cursor, so a participant that finishes
+    // early keeps taking work instead of idling behind a slow slice. body(participant, first, last).
+    template <typename Body>
+    void forEachChunk(int participants, std::int64_t count, std::int64_t grain, Body body) {
+        std::atomic<std::int64_t> cursor{0};
+        run(participants, [&](int participant) {
+            for (std::int64_t first = cursor.fetch_add(grain, std::memory_order_relaxed); first < count;
+                 first = cursor.fetch_add(grain, std::memory_order_relaxed)) {
+                body(participant, first, first + grain < count ? first + grain : count);
+            }
+        });
+    }
+
+private:
+    explicit ParallelPool(int threadCount);
+    void work(int participant);  // worker loop
+
+    std::vector<std::thread> threads_;  // participants 1..threadCount-1
+    std::mutex jobMutex_;  // held for the whole of one run()
+    std::mutex stateMutex_;  // guards everything below
+    std::condition_variable wake_;  // signalled when a job starts or on shutdown
+    std::condition_variable finished_;  // signalled when the last worker of a job is done
+    const std::function<void(int)>* body_{nullptr};  // current job
+    int participants_{0};  // participants in the current job, caller included
+    int remaining_{0};  // workers of the current job still running
+    std::uint64_t generation_{0};  // bumped per job so sleeping workers can tell a new one from a spurious wake
+    bool stopping_{false};
+};
@@ -0,0 +1,244 @@
+#include "Logic/perf_counters.h"
+
+#include <bit>
+#include <cinttypes>
+#include <cstdarg>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+constexpr int kOpCount = static_cast<int>(PerfOp::Count);
+constexpr double kPrometheusBounds[] = {1e-6, 1e-5, 1e-4, 1e-3, 1e-2, 1e-1, 1.0, 10.0};  // histogram "le" edges in seconds
+constexpr double kJsonQuantiles[] = {0.5, 0.9, 0.99, 0.999};
+constexpr const char* kJsonQuantileNames[] = {"p50_ns", "p90_ns", "p99_ns", "p999_ns"};
+
+void appendFormat(std::string& out, const char* format, ...) {
+    char line[256];
+    va_list arguments;
+    va_start(arguments, format);
+    const int length = std::vsnprintf(line, sizeof(line), format, arguments);
+    va_end(arguments);
+    if (length > 0) {
+        out.append(line, static_cast<std::size_t>(length < static_cast<int>(sizeof(line)) ? length : sizeof(line) - 1));
+    }
+}
+
+void raiseMaximum(std::atomic<std::uint64_t>& maximum, std::uint64_t value) {
+    std::uint64_t seen = maximum.load(std::memory_order_relaxed);
+    while (seen < value && !maximum.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+}
+}
+
+const char* perfOpName(PerfOp op) {
+    switch (op) {
+    case PerfOp::DetectCycle: return "detect_cycle";
+    case PerfOp::AddEdge: return "add_edge";
+    case PerfOp::AddEdges: return "add_edges";
+    case PerfOp::RemoveEdge: return "remove_edge";
+    case PerfOp::LoadGraph: return "load_graph";
+    case PerfOp::SynchronizeEdges: return "synchronize_edges";
+    case PerfOp::AnimationFrame: return "animation_frame";
+    case PerfOp::Count: break;
+    }
+    return "unknown";
+}
+
+int LatencyHistogram::bucketFor(std::uint64_t nanoseconds) {
+    if (nanoseconds < kSubBuckets) {
+        return static_cast<int>(nanoseconds);  // exact below the first power of two that needs splitting
+    }
+    const int exponent = (63 - std::countl_zero(nanoseconds)) - kSubBucketBits;
+    const int subBucket = static_cast<int>(nanoseconds >> exponent) - kSubBuckets;
+    return kSubBuckets + exponent * kSubBuckets + subBucket;
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(int bucket) {
+    if (bucket < kSubBuckets) {
+        return static_cast<std::uint64_t>(bucket);
+    }
+    const int exponent = (bucket - kSubBuckets) / kSubBuckets;
+    const std::uint64_t subBucket = static_cast<std::uint64_t>((bucket - kSubBuckets) % kSubBuckets);
+    const std::uint64_t lower = (kSubBuckets + subBucket) << exponent;
+    return lower + ((std::uint64_t(1) << exponent) - 1);
+}
+
+void LatencyHistogram::record(std::uint64_t nanoseconds) {
+    buckets_[bucketFor(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    total_.fetch_add(nanoseconds, std::memory_order_relaxed);
+    raiseMaximum(max_, nanoseconds);
+}
+
+std::uint64_t LatencyHistogram::count() const {
+    return count_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t LatencyHistogram::totalNanoseconds() const {
+    return total_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t LatencyHistogram::maxNanoseconds() const {
+    return max_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t LatencyHistogram::percentile(double fraction) const {
+    const std::uint64_t samples = count();
+    if (samples == 0) {
+        return 0;
+    }
+    const std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(fraction * static_cast<double>(samples)));
+    const std::uint64_t target = rank < 1 ? 1 : rank;
+    std::uint64_t seen = 0;
+    for (int bucket = 0; bucket < kBucketCount; ++bucket) {
+        seen += buckets_[bucket].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            const std::uint64_t upper = bucketUpperBound(bucket);
+            const std::uint64_t maximum = maxNanoseconds();
+            return upper < maximum ? upper : maximum;  // the top bucket is usually only partly filled
+        }
+    }
+    return maxNanoseconds();  // samples recorded while we were summing
+}
+
+std::uint64_t LatencyHistogram::countAtMost(std::uint64_t nanoseconds) const {
+    std::uint64_t total = 0;
+    for (int bucket = 0; bucket < kBucketCount && bucketUpperBound(bucket) <= nanoseconds; ++bucket) {
+        total += buckets_[bucket].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void LatencyHistogram::reset() {
+    for (std::atomic<std::uint64_t>& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    total_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+PerfCounters& PerfCounters::instance() {
+    static PerfCounters counters;
+    return counters;
+}
+
+void PerfCounters::setTimingEnabled(bool enabled) {
+    timingEnabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void PerfCounters::record(PerfOp op, std::uint64_t nanoseconds) {
+    histograms_[static_cast<int>(op)].record(nanoseconds);
+}
+
+const LatencyHistogram& PerfCounters::histogram(PerfOp op) const {
+    return histograms_[static_cast<int>(op)];
+}
+
+void PerfCounters::trackAdjacencyBytes(std::int64_t delta) {
+    const std::int64_t now = adjacencyBytes_.fetch_add(delta, std::memory_order_relaxed) + delta;
+    std::int64_t peak = peakAdjacencyBytes_.load(std::memory_order_relaxed);
+    while (peak < now && !peakAdjacencyBytes_.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+    }
+}
+
+std::int64_t PerfCounters::adjacencyBytes() const {
+    return adjacencyBytes_.load(std::memory_order_relaxed);
+}
+
+std::int64_t PerfCounters::peakAdjacencyBytes() const {
+    return peakAdjacencyBytes_.load(std::memory_order_relaxed);
+}
+
+void PerfCounters::reset() {
+    for (LatencyHistogram& histogram : histograms_) {
+        histogram.reset();
+    }
+    peakAdjacencyBytes_.store(adjacencyBytes(), std::memory_order_relaxed);
+}
+
+std::string PerfCounters::toPrometheus() const {
+    std::string out;
+    out += "# HELP neon_cycle_operation_duration_seconds Latency of instrumented graph operations.\n";
+    out += "# TYPE neon_cycle_operation_duration_seconds histogram\n";
+    for (int index = 0; index < kOpCount; ++index) {
+        const char* name = perfOpName(static_cast<PerfOp>(index));
+        const LatencyHistogram& histogram = histograms_[index];
+        const std::uint64_t samples = histogram.count();
+        for (double bound : kPrometheusBounds) {
+            appendFormat(out, "neon_cycle_operation_duration_seconds_bucket{op=\"%s\",le=\"%g\"} %" PRIu64 "\n", name, bound,
+                         histogram.countAtMost(static_cast<std::uint64_t>(bound * 1e9)));
+        }
+        appendFormat(out, "neon_cycle_operation_duration_seconds_bucket{op=\"%s\",le=\"+Inf\"} %" PRIu64 "\n", name, samples);
+        appendFormat(out, "neon_cycle_operation_duration_seconds_sum{op=\"%s\"} %.9f\n", name,
+                     static_cast<double>(histogram.totalNanoseconds()) / 1e9);
+        appendFormat(out, "neon_cycle_operation_duration_seconds_count{op=\"%s\"} %" PRIu64 "\n", name, samples);
+    }
+
+    out += "# HELP neon_cycle_adjacency_bytes Bytes held by adjacency storage (node pool blocks and owned CSR arrays).\n";
+    out += "# TYPE neon_cycle_adjacency_bytes gauge\n";
+    appendFormat(out, "neon_cycle_adjacency_bytes %lld\n", static_cast<long long>(adjacencyBytes()));
+    out += "# HELP neon_cycle_adjacency_peak_bytes High-water mark of neon_cycle_adjacency_bytes.\n";
+    out += "# TYPE neon_cycle_adjacency_peak_bytes gauge\n";
+    appendFormat(out, "neon_cycle_adjacency_peak_bytes %lld\n", static_cast<long long>(peakAdjacencyBytes()));
+    const long long peakKb = peakResidentKb();
+    if (peakKb >= 0) {  // a missing sample reads better than a bogus negative one
+        out += "# HELP neon_cycle_peak_resident_bytes Peak resident set size of the process.\n";
+        out += "# TYPE neon_cycle_peak_resident_bytes gauge\n";
+        appendFormat(out, "neon_cycle_peak_resident_bytes %lld\n", peakKb * 1024);
+    }
+    return out;
+}
+
+std::string PerfCounters::toJson() const {
+    std::string out = "{\"operations\":{";
+    for (int index = 0; index < kOpCount; ++index) {
+        const LatencyHistogram& histogram = histograms_[index];
+        appendFormat(out, "%s\"%s\":{\"count\":%" PRIu64 ",\"total_ns\":%" PRIu64 ",\"max_ns\":%" PRIu64, index == 0 ? "" : ",",
+                     perfOpName(static_cast<PerfOp>(index)), histogram.count(), histogram.totalNanoseconds(), histogram.maxNanoseconds());
+        for (std::size_t quantile = 0; quantile < std::size(kJsonQuantiles); ++quantile) {
+            appendFormat(out, ",\"%s\":%" PRIu64, kJsonQuantileNames[quantile], histogram.percentile(kJsonQuantiles[quantile]));
+        }
+        out += '}';
+    }
+    appendFormat(out, "},\"memory\":{\"adjacency_bytes\":%lld,\"adjacency_peak_bytes\":%lld,\"peak_rss_kb\":",
+                 static_cast<long long>(adjacencyBytes()), static_cast<long long>(peakAdjacencyBytes()));
+    const long long peakKb = peakResidentKb();
+    if (peakKb >= 0) {
+        appendFormat(out, "%lld}}", peakKb);
+    } else {
+        out += "null}}";
+    }
+    return out;
+}
+
+long long PerfCounters::peakResidentKb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return -1;
+    }
+    return static_cast<long long>(counters.PeakWorkingSetSize / 1024);
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;  // bytes on macOS
+#else
+    return usage.ru_maxrss;  // kilobytes on Linux
+#endif
+#endif
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#ifndef NEON_CYCLE_PERF_COUNTERS
+#define NEON_CYCLE_PERF_COUNTERS 1  // CMake passes 0 when the NEON_CYCLE_PERF_COUNTERS option is off
+#endif
+
+// Operations with their own call counter and latency histogram.
+enum class PerfOp {
+    DetectCycle,  // Graph::detectCycle, memoized answers included
+    AddEdge,  // Graph::addEdge, either overload
+    AddEdges,  // Graph::addEdges, one sample per batch
+    RemoveEdge,  // Graph::removeEdge
+    LoadGraph,  // GraphImporter::load and GraphSnapshot::load
+    SynchronizeEdges,  // GUI: rebuilding the graph from the drawn edges
+    AnimationFrame,  // GUI: one animation step
+    Count  // number of operations, not an operation
+};
+
+const char* perfOpName(PerfOp op);  // snake_case name used in both export formats
+
+// LatencyHistogram is an HDR-style log-linear histogram over nanoseconds: every power of two is split into
+// kSubBuckets linear buckets, so any recorded value is known to within 1/kSubBuckets (about 6%) from 1 ns to
+// centuries, in fixed memory. record() is wait-free and may be called from any thread.
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 4;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    void record(std::uint64_t nanoseconds);
+    std::uint64_t count() const;
+    std::uint64_t totalNanoseconds() const;
+    std::uint64_t maxNanoseconds() const;
+    std::uint64_t percentile(double fraction) const;  // upper edge of the bucket holding that quantile, 0 when empty
+    std::uint64_t countAtMost(std::uint64_t nanoseconds) const;  // samples whose whole bucket lies at or below the bound
+    void reset();  // not atomic with concurrent record() calls
+
+    static int bucketFor(std::uint64_t nanoseconds);  // index of the bucket holding a value
+    static std::uint64_t bucketUpperBound(int bucket);  // largest value that maps to bucket
+
+private:
+    std::array<std::atomic<std::uint64_t>, kBucketCount> buckets_{};
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> total_{0};
+    std::atomic<std::uint64_t> max_{0};
+};
+
+// PerfCounters is the process-wide registry behind the instrumentation: one histogram per PerfOp plus gauges for
+// the bytes held by adjacency storage (pool blocks and owned CSR arrays). Everything is lock-free, so the
+// engine, the CLI workers and the GUI can all record into it. Timing starts disabled; a front end that reports
+// the histograms turns it on with setTimingEnabled().
+class PerfCounters {
+public:
+    static PerfCounters& instance();
+    static void setTimingEnabled(bool enabled);  // arm or disarm every ScopedPerfTimer at runtime
+    static bool timingEnabled() { return timingEnabled_.load(std::memory_order_relaxed); }
+
+    void record(PerfOp op, std::uint64_t nanoseconds);
+    const LatencyHistogram& histogram(PerfOp op) const;
+    void trackAdjacencyBytes(std::int64_t delta);  // called when adjacency storage is allocated (+) or freed (-)
+    std::int64_t adjacencyBytes() const;  // bytes currently held by adjacency storage
+    std::int64_t peakAdjacencyBytes() const;  // high-water mark of adjacencyBytes()
+    void reset();  // zero every histogram and restart the peak from the current bytes
+
+    std::string toPrometheus() const;  // text exposition format, version 0.0.4
+    std::string toJson() const;  // one JSON object with per-operation percentiles and the memory gauges
+
+    static long long peakResidentKb();  // the process's peak resident set size, -1 if unavailable
+
+private:
+    PerfCounters() = default;
+
+    std::array<LatencyHistogram, static_cast<int>(PerfOp::Count)> histograms_;
+    std::atomic<std::int64_t> adjacencyBytes_{0};
+    std::atomic<std::int64_t> peakAdjacencyBytes_{0};
+    static inline std::atomic<bool> timingEnabled_{false};
+};
+
+// ScopedPerfTimer records the lifetime of a scope under one operation. While timing is disabled it costs one
+// relaxed load and reads no clock. Building with NEON_CYCLE_PERF_COUNTERS=0 turns it into an empty object.
+class ScopedPerfTimer {
+public:
+#if NEON_CYCLE_PERF_COUNTERS
+    explicit ScopedPerfTimer(PerfOp op) : op_(op), armed_(PerfCounters::timingEnabled()) {
+        if (armed_) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+    ~ScopedPerfTimer() {
+        if (!armed_) {
+            return;
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start_;
+        PerfCounters::instance().record(op_, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+#else
+    explicit ScopedPerfTimer(PerfOp) {}
+#endif
+
+    ScopedPerfTimer(const ScopedPerfTimer&) = delete;
+    ScopedPerfTimer& operator=(const ScopedPerfTimer&) = delete;
+
+#if NEON_CYCLE_PERF_COUNTERS
+private:
+    PerfOp op_;
+    bool armed_;  // timing was enabled when the scope opened
+    std::chrono::steady_clock::time_point start_;
+#endif
+};
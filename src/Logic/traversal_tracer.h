@@ -0,0 +1,14 @@
+#pragma once
+
+struct CycleWitness;
+
+// NullTraversalTracer is the default tracer policy for Graph's detectors. Every hook is an empty inline
+// function, so a detector instantiated with it compiles down to the untraced algorithm.
+// A custom tracer provides the same five member functions.
+struct NullTraversalTracer {
+    void nodeVisited(int) {}  // DFS discovered a vertex
+    void edgeTraversed(int, int) {}  // an edge (source, target) is being examined
+    void nodeBacktracked(int) {}  // DFS finished a vertex
+    void setsMerged(int, int) {}  // union-find joined the sets of an edge's endpoints
+    void cycleFound(const CycleWitness&) {}  // detection stopped on this cycle
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// VertexColors packs the white/gray/black DFS state of every vertex into two bits.
+class VertexColors {
+public:
+    enum Color : std::uint32_t {
+        White = 0,  // not discovered yet
+        Gray = 1,  // on the current DFS path
+        Black = 2  // fully explored
+    };
+
+    explicit VertexColors(int size) : words_((size + kColorsPerWord - 1) / kColorsPerWord, 0u) {}
+
+    Color get(int vertex) const {
+        return static_cast<Color>((words_[vertex / kColorsPerWord] >> shiftFor(vertex)) & kColorMask);
+    }
+
+    void set(int vertex, Color color) {
+        std::uint32_t& word = words_[vertex / kColorsPerWord];
+        word = (word & ~(kColorMask << shiftFor(vertex))) | (static_cast<std::uint32_t>(color) << shiftFor(vertex));
+    }
+
+private:
+    static constexpr int kColorsPerWord = 16;  // 32-bit words hold sixteen 2-bit colors
+    static constexpr std::uint32_t kColorMask = 3u;
+
+    static int shiftFor(int vertex) { return (vertex % kColorsPerWord) * 2; }
+
+    std::vector<std::uint32_t> words_;  // packed color table
+};
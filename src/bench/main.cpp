@@ -0,0 +1,223 @@
+// neon-cycle-bench: microbenchmarks for Graph and DisjointSet across graph shapes and sizes.
+// Prints one JSON (default) or CSV line per (operation, shape, size) with ns/op, edges/s and the process's peak RSS.
+
+#include "Logic/cycle_search.h"
+#include "Logic/disjoint_set.h"
+#include "Logic/graph.h"
+#include "Logic/graph_generator.h"
+#include "Logic/parallel_cycle_detector.h"
+#include "Logic/perf_counters.h"
+#include "Logic/traversal_tracer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+using EdgeList = std::vector<std::pair<int, int>>;
+
+constexpr double kMinSampleNs = 20e6;  // repeat small cases until this much time was measured
+constexpr int kMaxRepetitions = 1000;  // ...or this many runs, whichever comes first
+constexpr double kMaxWallNs = 1e9;  // ...or once setup plus measurement took this long, for cheap ops with costly setup
+constexpr int kDenseVertexLimit = 4096;  // dense shapes grow quadratically, so stop here
+
+struct Shape {
+    const char* name;
+    bool directed;
+    std::function<bool(GraphGenerator&, Graph&, int)> build;  // fill graph with this shape at the given vertex count
+    int vertexLimit;  // larger sizes are skipped for this shape
+};
+
+volatile long long benchmarkSink = 0;  // keeps results observable so the timed work is not optimized away
+
+bool buildChain(GraphGenerator& generator, Graph& graph, int vertexCount) {
+    return generator.chain(graph, vertexCount, true);
+}
+
+bool buildTree(GraphGenerator& generator, Graph& graph, int vertexCount) {
+    return generator.barabasiAlbert(graph, vertexCount, 1, false);  // one link per newcomer, so a tree
+}
+
+bool buildSparse(GraphGenerator& generator, Graph& graph, int vertexCount) {
+    return generator.erdosRenyi(graph, vertexCount, static_cast<std::int64_t>(vertexCount) * 2, false);  // average degree 4
+}
+
+bool buildDense(GraphGenerator& generator, Graph& graph, int vertexCount) {
+    const std::int64_t pairs = static_cast<std::int64_t>(vertexCount) * (vertexCount - 1) / 2;
+    return generator.erdosRenyi(graph, vertexCount, pairs / 4, false);  // a quarter of all pairs
+}
+
+bool buildDag(GraphGenerator& generator, Graph& graph, int vertexCount) {
+    return generator.randomDag(graph, vertexCount, static_cast<std::int64_t>(vertexCount) * 2);
+}
+
+// The shape's edges as (source, target) pairs, each undirected edge once, in a random insertion order.
+EdgeList generateEdges(const Shape& shape, int vertexCount, std::mt19937_64& random) {
+    Graph graph;
+    GraphGenerator generator(random());
+    EdgeList edges;
+    if (!shape.build(generator, graph, vertexCount)) {
+        return edges;
+    }
+    edges.reserve(static_cast<std::size_t>(graph.edgeCount()));
+    for (int vertex = 0; vertex < vertexCount; ++vertex) {
+        for (int neighbor : graph.neighbors(vertex)) {
+            if (shape.directed || vertex <= neighbor) {
+                edges.emplace_back(vertex, neighbor);
+            }
+        }
+    }
+    std::shuffle(edges.begin(), edges.end(), random);
+    return edges;
+}
+
+// Runs prepare() then the timed op() until enough time was sampled; returns the mean time of one op() call.
+double measure(const std::function<void()>& prepare, const std::function<void()>& op) {
+    double totalNs = 0.0;
+    int repetitions = 0;
+    const auto wallStart = std::chrono::steady_clock::now();
+    const auto wallNs = [&] { return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - wallStart).count(); };
+    while (repetitions == 0 || (repetitions < kMaxRepetitions && totalNs < kMinSampleNs && wallNs() < kMaxWallNs)) {
+        prepare();
+        const auto start = std::chrono::steady_clock::now();
+        op();
+        totalNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        ++repetitions;
+    }
+    return totalNs / repetitions;
+}
+
+void report(bool csv, const char* op, const Shape& shape, int vertexCount, std::int64_t edgeCount, std::int64_t opsPerRun,
+            double nsPerRun) {
+    const double nsPerOp = opsPerRun > 0 ? nsPerRun / opsPerRun : nsPerRun;
+    const double edgesPerSecond = nsPerRun > 0.0 ? edgeCount * 1e9 / nsPerRun : 0.0;
+    if (csv) {
+        std::printf("%s,%s,%d,%lld,%.2f,%.0f,%lld\n", op, shape.name, vertexCount, static_cast<long long>(edgeCount),
+                    nsPerOp, edgesPerSecond, PerfCounters::peakResidentKb());
+    } else {
+        std::printf("{\"op\":\"%s\",\"shape\":\"%s\",\"vertices\":%d,\"edges\":%lld,\"ns_per_op\":%.2f,"
+                    "\"edges_per_sec\":%.0f,\"peak_rss_kb\":%lld}\n",
+                    op, shape.name, vertexCount, static_cast<long long>(edgeCount), nsPerOp, edgesPerSecond,
+                    PerfCounters::peakResidentKb());
+    }
+    std::fflush(stdout);
+}
+
+void runShape(const Shape& shape, int vertexCount, std::mt19937_64& random, bool csv) {
+    const EdgeList edges = generateEdges(shape, vertexCount, random);
+    const std::int64_t edgeCount = static_cast<std::int64_t>(edges.size());
+
+    // addEdge: one call per edge into an empty graph.
+    Graph graph(vertexCount, shape.directed);
+    double ns = measure([&] { graph.configure(vertexCount, shape.directed); }, [&] {
+        for (const auto& [source, target] : edges) {
+            graph.addEdge(source, target);
+        }
+    });
+    report(csv, "addEdge", shape, vertexCount, edgeCount, edgeCount, ns);
+
+    // detectCycle: a full run of each engine. detectCycle() itself would answer undirected graphs from the
+    // union-find that addEdges already maintained, so call the detectors directly. The parallel run rebuilds
+    // first because on a single core it defers to the serial DFS, whose witness is memoized per version.
+    const auto rebuild = [&] {
+        graph.configure(vertexCount, shape.directed);
+        graph.addEdges(edges);
+    };
+    rebuild();
+    NullTraversalTracer tracer;
+    ns = measure([] {}, [&] { benchmarkSink = benchmarkSink + graph.traceCycle(tracer).isEmpty(); });
+    report(csv, "detectCycle", shape, vertexCount, graph.edgeCount(), 1, ns);
+    const ParallelCycleDetector detector;
+    ns = measure(rebuild, [&] {
+        benchmarkSink = benchmarkSink + (shape.directed ? detector.hasDirectedCycle(graph) : detector.hasUndirectedCycle(graph));
+    });
+    report(csv, "detectCycleParallel", shape, vertexCount, graph.edgeCount(), 1, ns);
+
+    // getAdjacencyList: full deep copy of the adjacency data.
+    ns = measure([] {}, [&] { benchmarkSink = benchmarkSink + graph.getAdjacencyList().size(); });
+    report(csv, "getAdjacencyList", shape, vertexCount, graph.edgeCount(), 1, ns);
+
+    // removeEdge: tear the graph down one edge at a time, in insertion order.
+    ns = measure(rebuild, [&] {
+        for (const auto& [source, target] : edges) {
+            graph.removeEdge(source, target);
+        }
+    });
+    report(csv, "removeEdge", shape, vertexCount, edgeCount, edgeCount, ns);
+
+    // DisjointSet::find: every vertex once, in random order, after uniting along all edges.
+    DisjointSet sets(vertexCount);
+    for (const auto& [source, target] : edges) {
+        sets.unionSets(sets.find(source), sets.find(target));
+    }
+    std::vector<int> queries(vertexCount);
+    for (int vertex = 0; vertex < vertexCount; ++vertex) {
+        queries[vertex] = vertex;
+    }
+    std::shuffle(queries.begin(), queries.end(), random);
+    ns = measure([] {}, [&] {
+        long long sum = 0;
+        for (int vertex : queries) {
+            sum += sets.find(vertex);
+        }
+        benchmarkSink = benchmarkSink + sum;
+    });
+    report(csv, "DisjointSet::find", shape, vertexCount, edgeCount, vertexCount, ns);
+}
+
+void printUsage(std::FILE* stream) {
+    std::fputs("usage: neon-cycle-bench [--format json|csv] [--max-vertices N] [--seed S]\n"
+               "  sizes run from 10 up to --max-vertices (default 1000000, at most 10000000)\n",
+               stream);
+}
+}
+
+int main(int argc, char** argv) {
+    bool csv = false;
+    int maxVertices = 1000000;
+    unsigned long long seed = 42;
+    for (int index = 1; index < argc; ++index) {
+        const bool hasValue = index + 1 < argc;
+        if (std::strcmp(argv[index], "--format") == 0 && hasValue) {
+            csv = std::strcmp(argv[++index], "csv") == 0;
+        } else if (std::strcmp(argv[index], "--max-vertices") == 0 && hasValue) {
+            maxVertices = std::atoi(argv[++index]);
+        } else if (std::strcmp(argv[index], "--seed") == 0 && hasValue) {
+            seed = std::strtoull(argv[++index], nullptr, 10);
+        } else {
+            printUsage(std::strcmp(argv[index], "--help") == 0 ? stdout : stderr);
+            return std::strcmp(argv[index], "--help") == 0 ? 0 : 2;
+        }
+    }
+
+    const std::vector<Shape> shapes = {
+        {"chain", true, buildChain, 10000000},
+        {"tree", false, buildTree, 10000000},
+        {"sparse", false, buildSparse, 10000000},
+        {"dense", false, buildDense, kDenseVertexLimit},
+        {"dag", true, buildDag, 10000000},
+    };
+    const int sizes[] = {10, 1000, 100000, 1000000, 10000000};
+
+    if (csv) {
+        std::puts("op,shape,vertices,edges,ns_per_op,edges_per_sec,peak_rss_kb");
+    }
+    for (const Shape& shape : shapes) {
+        for (int vertexCount : sizes) {
+            if (vertexCount > maxVertices || vertexCount > shape.vertexLimit) {
+                continue;
+            }
+            std::mt19937_64 random(seed);
+            runShape(shape, vertexCount, random, csv);
+        }
+    }
+    return 0;
+}
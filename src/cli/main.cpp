@@ -0,0 +1,377 @@
+// neon-cycle-cli: headless batch cycle detection over edge-list, SNAP, DIMACS and snapshot files.
+// Every input file is one task on a work-stealing pool; results stream out as one JSON or CSV line per file.
+// --generate adds one seeded synthetic graph to the batch, optionally saved as a snapshot for later runs.
+// --metrics dumps the engine's PerfCounters (latency histograms and memory gauges) once the batch is done.
+
+#include "cli/work_stealing_pool.h"
+#include "Logic/file_util.h"
+#include "Logic/graph.h"
+#include "Logic/graph_generator.h"
+#include "Logic/graph_io.h"
+#include "Logic/graph_snapshot.h"
+#include "Logic/perf_counters.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+enum class OutputFormat { Json, Csv };
+enum class MetricsFormat { None, Json, Prometheus };
+
+struct Options {
+    OutputFormat format{OutputFormat::Json};
+    int threads{0};  // 0 = one per core
+    bool directed{true};
+    bool verify{false};  // snapshots open in O(1) and are trusted unless --verify asks for the O(V+E) check
+    ExecutionPolicy policy{ExecutionPolicy::Serial};  // files already run in parallel, so each check stays serial by default
+    std::vector<std::string> inputs;
+
+    std::string generate;  // generator kind, empty when only files are checked
+    int vertices{1000};
+    std::int64_t edges{4000};
+    int cycles{1};  // planted cycles for the "planted" kind
+    int perVertex{3};  // edges per new vertex for the "ba" kind
+    std::uint64_t seed{0};
+    std::string savePath;  // snapshot destination for the generated graph
+
+    MetricsFormat metrics{MetricsFormat::None};
+    std::string metricsPath;  // metrics destination, stderr when empty
+};
+
+struct FileResult {
+    std::string file;
+    int vertices{0};
+    std::int64_t edges{0};
+    std::int64_t skipped{0};  // edge lines the importer ignored; always 0 for snapshots and generated graphs
+    bool directed{false};
+    bool cyclic{false};
+    double loadMs{0.0};
+    double detectMs{0.0};
+    std::string error;  // empty on success
+};
+
+void printUsage(std::FILE* stream) {
+    std::fputs("usage: neon-cycle-cli [options] <file-or-directory>...\n"
+               "  --format json|csv          result line format (default json)\n"
+               "  --threads N                worker threads, 0 = one per core (default 0)\n"
+               "  --directed | --undirected  how to read edge lists (default directed; snapshots carry their own)\n"
+               "  --policy serial|parallel|auto  per-file detection engine (default serial)\n"
+               "  --verify                   check snapshot structure, vertex ids and checksum first (one O(V+E) pass)\n"
+               "  --generate er|ba|grid|chain|dag|planted  also check one synthetic graph built from:\n"
+               "      --vertices N (default 1000; grid uses the largest square that fits)  --edges M (default 4000)\n"
+               "      --cycles K (planted, default 1)  --per-vertex D (ba, default 3)  --seed S (default 0)\n"
+               "      --save FILE (also write the generated graph as a snapshot)\n"
+               "  --metrics json|prometheus  dump operation latencies and memory gauges after the batch\n"
+               "  --metrics-out FILE         write the metrics to FILE instead of stderr\n",
+               stream);
+}
+
+bool parseArguments(int argc, char** argv, Options& options) {
+    for (int index = 1; index < argc; ++index) {
+        const std::string argument = argv[index];
+        const bool hasValue = index + 1 < argc;
+        if (argument == "--format" && hasValue) {
+            const std::string value = argv[++index];
+            if (value != "json" && value != "csv") {
+                return false;
+            }
+            options.format = value == "csv" ? OutputFormat::Csv : OutputFormat::Json;
+        } else if (argument == "--threads" && hasValue) {
+            options.threads = std::atoi(argv[++index]);
+        } else if (argument == "--policy" && hasValue) {
+            const std::string value = argv[++index];
+            if (value == "serial") {
+                options.policy = ExecutionPolicy::Serial;
+            } else if (value == "parallel") {
+                options.policy = ExecutionPolicy::Parallel;
+            } else if (value == "auto") {
+                options.policy = ExecutionPolicy::Automatic;
+            } else {
+                return false;
+            }
+        } else if (argument == "--directed") {
+            options.directed = true;
+        } else if (argument == "--undirected") {
+            options.directed = false;
+        } else if (argument == "--verify") {
+            options.verify = true;
+        } else if (argument == "--trust-snapshots") {
+            options.verify = false;  // the default; kept so existing scripts still parse
+        } else if (argument == "--generate" && hasValue) {
+            options.generate = argv[++index];
+        } else if (argument == "--vertices" && hasValue) {
+            options.vertices = std::atoi(argv[++index]);
+        } else if (argument == "--edges" && hasValue) {
+            options.edges = std::atoll(argv[++index]);
+        } else if (argument == "--cycles" && hasValue) {
+            options.cycles = std::atoi(argv[++index]);
+        } else if (argument == "--per-vertex" && hasValue) {
+            options.perVertex = std::atoi(argv[++index]);
+        } else if (argument == "--seed" && hasValue) {
+            options.seed = std::strtoull(argv[++index], nullptr, 10);
+        } else if (argument == "--save" && hasValue) {
+            options.savePath = argv[++index];
+        } else if (argument == "--metrics" && hasValue) {
+            const std::string value = argv[++index];
+            if (value == "json") {
+                options.metrics = MetricsFormat::Json;
+            } else if (value == "prometheus") {
+                options.metrics = MetricsFormat::Prometheus;
+            } else {
+                return false;
+            }
+        } else if (argument == "--metrics-out" && hasValue) {
+            options.metricsPath = argv[++index];
+        } else if (!argument.empty() && argument[0] == '-') {
+            return false;
+        } else {
+            options.inputs.push_back(argument);
+        }
+    }
+    return !options.inputs.empty() || !options.generate.empty();
+}
+
+// Expands directories into their regular files (sorted, non-recursive) and keeps plain paths as given.
+std::vector<std::string> collectFiles(const std::vector<std::string>& inputs) {
+    std::vector<std::string> files;
+    for (const std::string& input : inputs) {
+        std::error_code error;
+        if (!std::filesystem::is_directory(input, error)) {
+            files.push_back(input);
+            continue;
+        }
+        std::vector<std::string> entries;
+        for (const auto& entry : std::filesystem::directory_iterator(input, error)) {
+            if (entry.is_regular_file(error)) {
+                entries.push_back(entry.path().string());
+            }
+        }
+        std::sort(entries.begin(), entries.end());
+        files.insert(files.end(), entries.begin(), entries.end());
+    }
+    return files;
+}
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+FileResult processFile(const std::string& file, const Options& options) {
+    FileResult result;
+    result.file = file;
+
+    const std::filesystem::path path(file);
+    Graph graph;
+    const auto loadStart = std::chrono::steady_clock::now();
+    if (GraphSnapshot::probe(path)) {
+        GraphSnapshot snapshot;
+        if (!snapshot.load(path, graph, options.verify)) {
+            result.error = errorMessage(snapshot.getLastError());
+        }
+    } else {
+        GraphImporter importer;
+        if (importer.load(path, options.directed, graph)) {
+            graph.freeze();  // detection walks contiguous CSR arrays instead of the lists the import built
+        } else {
+            result.error = errorMessage(importer.getLastError());
+        }
+        result.skipped = importer.linesSkipped();
+    }
+    result.loadMs = millisecondsSince(loadStart);
+    if (!result.error.empty()) {
+        return result;
+    }
+
+    result.vertices = graph.vertexCount();
+    result.edges = graph.edgeCount();
+    result.directed = graph.isDirected();
+    const auto detectStart = std::chrono::steady_clock::now();
+    result.cyclic = graph.detectCycle(options.policy);
+    result.detectMs = millisecondsSince(detectStart);
+    return result;
+}
+
+// Builds the requested synthetic graph; its "load" time is the generation time.
+FileResult processGenerated(const Options& options) {
+    FileResult result;
+    result.file = "generated:" + options.generate;
+
+    Graph graph;
+    GraphGenerator generator(options.seed);
+    const auto loadStart = std::chrono::steady_clock::now();
+    bool built = false;
+    if (options.generate == "er") {
+        built = generator.erdosRenyi(graph, options.vertices, options.edges, options.directed);
+    } else if (options.generate == "ba") {
+        built = generator.barabasiAlbert(graph, options.vertices, options.perVertex, options.directed);
+    } else if (options.generate == "grid") {
+        const int side = static_cast<int>(std::sqrt(static_cast<double>(std::max(options.vertices, 0))));
+        built = generator.grid(graph, side, side, options.directed);
+    } else if (options.generate == "chain") {
+        built = generator.chain(graph, options.vertices, options.directed);
+    } else if (options.generate == "dag") {
+        built = generator.randomDag(graph, options.vertices, options.edges);
+    } else if (options.generate == "planted") {
+        built = generator.dagWithPlantedCycles(graph, options.vertices, options.edges, options.cycles);
+    } else {
+        result.error = "Unknown generator " + options.generate + ".";
+        return result;
+    }
+    if (built) {
+        graph.freeze();
+    }
+    result.loadMs = millisecondsSince(loadStart);
+    if (!built) {
+        result.error = errorMessage(generator.getLastError());
+        return result;
+    }
+
+    if (!options.savePath.empty()) {
+        GraphSnapshot snapshot;
+        if (!snapshot.save(graph, options.savePath)) {
+            result.error = errorMessage(snapshot.getLastError());
+            return result;
+        }
+    }
+
+    result.vertices = graph.vertexCount();
+    result.edges = graph.edgeCount();
+    result.directed = graph.isDirected();
+    const auto detectStart = std::chrono::steady_clock::now();
+    result.cyclic = graph.detectCycle(options.policy);
+    result.detectMs = millisecondsSince(detectStart);
+    return result;
+}
+
+std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    escaped.reserve(text.size() + 2);
+    for (const char character : text) {
+        switch (character) {
+        case '"': escaped += "\\\""; break;
+        case '\\': escaped += "\\\\"; break;
+        case '\n': escaped += "\\n"; break;
+        case '\t': escaped += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(character) < 0x20) {
+                char code[8];
+                std::snprintf(code, sizeof(code), "\\u%04x", character);
+                escaped += code;
+            } else {
+                escaped += character;
+            }
+        }
+    }
+    return escaped;
+}
+
+std::string csvField(const std::string& text) {
+    if (text.find_first_of(",\"\n") == std::string::npos) {
+        return text;
+    }
+    std::string quoted = "\"";
+    for (const char character : text) {
+        quoted += character;
+        if (character == '"') {
+            quoted += '"';
+        }
+    }
+    return quoted + "\"";
+}
+
+void printResult(const FileResult& result, OutputFormat format) {
+    // A failed load or generation has no verdict, so directed and cyclic are left empty rather than reading false.
+    const bool failed = !result.error.empty();
+    if (format == OutputFormat::Json) {
+        const char* directed = failed ? "null" : (result.directed ? "true" : "false");
+        const char* cyclic = failed ? "null" : (result.cyclic ? "true" : "false");
+        std::printf("{\"file\":\"%s\",\"vertices\":%d,\"edges\":%lld,\"skipped\":%lld,\"directed\":%s,\"cyclic\":%s,"
+                    "\"load_ms\":%.3f,\"detect_ms\":%.3f,\"error\":%s}\n",
+                    jsonEscape(result.file).c_str(), result.vertices, static_cast<long long>(result.edges),
+                    static_cast<long long>(result.skipped), directed, cyclic, result.loadMs,
+                    result.detectMs, failed ? ("\"" + jsonEscape(result.error) + "\"").c_str() : "null");
+    } else {
+        const char* directed = failed ? "" : (result.directed ? "1" : "0");
+        const char* cyclic = failed ? "" : (result.cyclic ? "1" : "0");
+        std::printf("%s,%d,%lld,%lld,%s,%s,%.3f,%.3f,%s\n", csvField(result.file).c_str(), result.vertices,
+                    static_cast<long long>(result.edges), static_cast<long long>(result.skipped), directed, cyclic,
+                    result.loadMs, result.detectMs, csvField(result.error).c_str());
+    }
+    std::fflush(stdout);  // keep lines whole and timely when piped
+}
+
+bool writeMetrics(const Options& options) {
+    const PerfCounters& counters = PerfCounters::instance();
+    std::string text = options.metrics == MetricsFormat::Json ? counters.toJson() + "\n" : counters.toPrometheus();
+    if (options.metricsPath.empty()) {
+        std::fputs(text.c_str(), stderr);
+        return true;
+    }
+
+    std::FILE* file = openFile(std::filesystem::path(options.metricsPath), "wb");
+    if (!file) {
+        std::fprintf(stderr, "%s: %s\n", options.metricsPath.c_str(), errorMessage(GraphError::OpenFailed));
+        return false;
+    }
+    const bool written = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+    const bool closed = std::fclose(file) == 0;
+    if (!written || !closed) {
+        std::fprintf(stderr, "%s: %s\n", options.metricsPath.c_str(), errorMessage(GraphError::WriteFailed));
+    }
+    return written && closed;
+}
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (argc > 1 && (std::strcmp(argv[1], "--help") == 0 || std::strcmp(argv[1], "-h") == 0)) {
+        printUsage(stdout);
+        return 0;
+    }
+    if (!parseArguments(argc, argv, options)) {
+        printUsage(stderr);
+        return 2;
+    }
+    PerfCounters::setTimingEnabled(options.metrics != MetricsFormat::None);  // untimed unless someone reads the numbers
+
+    const std::vector<std::string> files = collectFiles(options.inputs);
+    if (options.format == OutputFormat::Csv) {
+        std::puts("file,vertices,edges,skipped,directed,cyclic,load_ms,detect_ms,error");
+    }
+
+    std::mutex outputMutex;  // one result line at a time
+    bool anyFailed = false;
+    {
+        WorkStealingPool pool(options.threads);
+        if (!options.generate.empty()) {
+            pool.submit([&] {
+                const FileResult result = processGenerated(options);
+                std::lock_guard<std::mutex> lock(outputMutex);
+                anyFailed = anyFailed || !result.error.empty();
+                printResult(result, options.format);
+            });
+        }
+        for (const std::string& file : files) {
+            pool.submit([&, file] {
+                const FileResult result = processFile(file, options);
+                std::lock_guard<std::mutex> lock(outputMutex);
+                anyFailed = anyFailed || !result.error.empty();
+                printResult(result, options.format);
+            });
+        }
+        pool.wait();
+    }
+    if (options.metrics != MetricsFormat::None && !writeMetrics(options)) {
+        anyFailed = true;
+    }
+    return anyFailed ? 1 : 0;
+}
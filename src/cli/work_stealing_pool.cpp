@@ -0,0 +1,100 @@
+#include "cli/work_stealing_pool.h"
+
+WorkStealingPool::WorkStealingPool(int threadCount) {
+    int count = threadCount > 0 ? threadCount : static_cast<int>(std::thread::hardware_concurrency());
+    if (count < 1) {
+        count = 1;
+    }
+
+    workers_.reserve(count);
+    for (int index = 0; index < count; ++index) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    threads_.reserve(count);
+    for (int index = 0; index < count; ++index) {
+        threads_.emplace_back([this, index] { run(index); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        stopping_ = true;
+    }
+    taskAvailable_.notify_all();
+    for (std::thread& thread : threads_) {
+        thread.join();
+    }
+}
+
+int WorkStealingPool::threadCount() const {
+    return static_cast<int>(threads_.size());
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    Worker& worker = *workers_[nextWorker_];
+    nextWorker_ = (nextWorker_ + 1) % static_cast<int>(workers_.size());
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        ++unfinished_;
+        queued_.fetch_add(1, std::memory_order_release);
+    }
+    taskAvailable_.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    allDone_.wait(lock, [this] { return unfinished_ == 0; });
+}
+
+bool WorkStealingPool::takeTask(int index, std::function<void()>& task) {
+    {
+        Worker& own = *workers_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    const int count = static_cast<int>(workers_.size());
+    for (int offset = 1; offset < count; ++offset) {
+        Worker& victim = *workers_[(index + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::run(int index) {
+    std::function<void()> task;
+    while (true) {
+        if (takeTask(index, task)) {
+            queued_.fetch_sub(1, std::memory_order_acq_rel);
+            task();
+            task = nullptr;  // release captured state before reporting completion
+
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            if (--unfinished_ == 0) {
+                allDone_.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(stateMutex_);
+        taskAvailable_.wait(lock, [this] { return stopping_ || queued_.load(std::memory_order_acquire) > 0; });
+        if (stopping_ && queued_.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
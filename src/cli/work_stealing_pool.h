@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// WorkStealingPool runs independent tasks on a fixed set of threads.
+// Each worker owns a deque: it pops its own newest task, and when empty steals the oldest task from a peer,
+// so a few large graphs do not leave the other workers idle behind them.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int threadCount = 0);  // 0 picks one thread per hardware core
+    ~WorkStealingPool();  // finishes queued tasks, then joins the workers
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(std::function<void()> task);  // queue a task on the next worker, round-robin
+    void wait();  // block until every submitted task has finished
+    int threadCount() const;  // number of worker threads
+
+private:
+    struct Worker {
+        std::mutex mutex;  // guards tasks; held only for a push or pop
+        std::deque<std::function<void()>> tasks;  // owner takes from the back, thieves from the front
+    };
+
+    void run(int index);  // worker loop
+    bool takeTask(int index, std::function<void()>& task);  // own queue first, then steal
+
+    std::vector<std::unique_ptr<Worker>> workers_;  // one queue per thread
+    std::vector<std::thread> threads_;  // the worker threads
+    std::mutex stateMutex_;  // guards the sleep/wake handshake below
+    std::condition_variable taskAvailable_;  // signalled on submit and shutdown
+    std::condition_variable allDone_;  // signalled when unfinished_ drops to zero
+    std::atomic<int> queued_{0};  // tasks sitting in some queue
+    int unfinished_{0};  // tasks submitted but not yet completed, guarded by stateMutex_
+    int nextWorker_{0};  // round-robin cursor for submit()
+    bool stopping_{false};  // set by the destructor, guarded by stateMutex_
+};
@@ -0,0 +1,393 @@
+#include "edgelayer.h"
+
+#include <QGraphicsScene>
+#include <QGraphicsSceneMouseEvent>
+#include <QGraphicsView>
+#include <QPainter>
+#include <QPainterPath>
+#include <QPen>
+#include <QPolygonF>
+#include <QStyleOptionGraphicsItem>
+#include <QtCore/Qt>
+#include <QtGlobal>
+#include <cmath>
+
+namespace {
+const QColor kEdgeColor(54, 252, 215);
+const QColor kDirectedEdgeColor(255, 105, 180);
+constexpr qreal kEdgeWidth = 3.0;
+constexpr qreal kHighlightWidth = kEdgeWidth + 1.5;
+constexpr qreal kArrowSize = 26.0;
+constexpr qreal kArrowMinPixels = 5.0;  // arrowheads smaller than this on screen are skipped
+constexpr qreal kHitPixels = 6.0;  // click tolerance around an edge, in screen pixels
+constexpr qreal kMinCellSize = 64.0;  // grid cells never get smaller than this many scene units
+constexpr int kSamplesPerEdge = 4;  // grid cells are sized so an average edge crosses about this many
+constexpr int kMaxSearchRing = 8;  // cap on cells searched around a click when zoomed far out
+
+qreal distanceToSegment(const QPointF& point, const QLineF& line)
+{
+    const QPointF direction = line.p2() - line.p1();
+    const qreal lengthSquared = QPointF::dotProduct(direction, direction);
+    qreal t = 0;
+    if (lengthSquared > 0) {
+        t = qBound<qreal>(0, QPointF::dotProduct(point - line.p1(), direction) / lengthSquared, 1);
+    }
+    const QPointF nearest = line.p1() + direction * t;
+    return std::hypot(point.x() - nearest.x(), point.y() - nearest.y());
+}
+}
+
+EdgeLayer::EdgeLayer(QGraphicsItem* parent)
+    : QGraphicsObject(parent)
+{
+    setZValue(0);  // nodes sit above at z = 1
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);  // exposedRect drives the culling in paint()
+    setAcceptedMouseButtons(Qt::NoButton);  // clicks pass through to the view until delete mode is on
+}
+
+EdgeLayer::Arrow EdgeLayer::arrowFor(const QLineF& line) const
+{
+    const qreal length = line.length();
+    const QPointF midPoint = line.center();
+    if (qFuzzyIsNull(length)) {
+        return {midPoint, midPoint, midPoint};
+    }
+
+    // Unit direction and its normal replace the atan2/cos/sin the per-edge items used to run on every paint.
+    const QPointF along = (line.p2() - line.p1()) / length;
+    const QPointF across(-along.y(), along.x());
+    const qreal halfLength = kArrowSize / 2;
+    const qreal halfWidth = kArrowSize * 0.7 / 2;
+    return {midPoint + along * halfLength, midPoint + across * halfWidth, midPoint - across * halfWidth};
+}
+
+QRectF EdgeLayer::extentOf(const QLineF& line) const
+{
+    const qreal margin = kArrowSize / 2 + kHighlightWidth;
+    return QRectF(line.p1(), line.p2()).normalized().adjusted(-margin, -margin, margin, margin);
+}
+
+void EdgeLayer::growBounds(const QRectF& extent)
+{
+    if (!bounds_.contains(extent)) {
+        prepareGeometryChange();
+        bounds_ = bounds_.isNull() ? extent : bounds_.united(extent);
+    }
+}
+
+void EdgeLayer::append(const QPointF& source, const QPointF& target)
+{
+    const QLineF line(source, target);
+    lines_.append(line);
+    arrows_.append(arrowFor(line));
+    if (!gridStale_) {
+        if (lines_.size() > 2 * gridSizedFor_) {
+            gridStale_ = true;  // cells fitted to a much smaller graph; refit on next use
+        } else {
+            insertIntoGrid(lines_.size() - 1);
+        }
+    }
+    growBounds(extentOf(line));
+    update(extentOf(line));
+}
+
+void EdgeLayer::move(int edge, const QPointF& source, const QPointF& target)
+{
+    if (edge < 0 || edge >= lines_.size()) {
+        return;
+    }
+
+    const QRectF before = extentOf(lines_.at(edge));
+    const QLineF line(source, target);
+    if (!gridStale_) {
+        eraseFromGrid(edge);
+    }
+    lines_[edge] = line;
+    arrows_[edge] = arrowFor(line);
+    if (!gridStale_) {
+        insertIntoGrid(edge);
+    }
+    growBounds(extentOf(line));
+    update(before);  // repaint just the old and new strips, not the whole layer
+    update(extentOf(line));
+}
+
+void EdgeLayer::removeAt(int edge)
+{
+    if (edge < 0 || edge >= lines_.size()) {
+        return;
+    }
+
+    update(extentOf(lines_.at(edge)));
+    highlights_.remove(edge);
+    const int last = lines_.size() - 1;
+    if (!gridStale_) {
+        eraseFromGrid(edge);
+        if (edge != last) {
+            eraseFromGrid(last);
+        }
+    }
+    if (edge != last) {
+        lines_[edge] = lines_.at(last);
+        arrows_[edge] = arrows_.at(last);
+        if (highlights_.contains(last)) {
+            highlights_.insert(edge, highlights_.take(last));
+        }
+        if (!gridStale_) {
+            insertIntoGrid(edge);
+        }
+    }
+    lines_.removeLast();
+    arrows_.removeLast();
+}
+
+void EdgeLayer::clear()
+{
+    prepareGeometryChange();
+    lines_.clear();
+    arrows_.clear();
+    highlights_.clear();
+    bounds_ = QRectF();
+    grid_.clear();
+    gridStale_ = true;
+}
+
+void EdgeLayer::setDirected(bool directed)
+{
+    if (directed_ == directed) {
+        return;
+    }
+    directed_ = directed;
+    update();
+}
+
+void EdgeLayer::setDeleteMode(bool enabled)
+{
+    deleteMode_ = enabled;
+    setAcceptedMouseButtons(enabled ? Qt::LeftButton : Qt::NoButton);
+}
+
+void EdgeLayer::highlight(int edge, const QColor& color)
+{
+    if (edge < 0 || edge >= lines_.size()) {
+        return;
+    }
+    highlights_.insert(edge, color);
+    update(extentOf(lines_.at(edge)));
+}
+
+void EdgeLayer::resetHighlights()
+{
+    for (auto it = highlights_.cbegin(); it != highlights_.cend(); ++it) {
+        update(extentOf(lines_.at(it.key())));
+    }
+    highlights_.clear();
+}
+
+QRectF EdgeLayer::boundingRect() const
+{
+    return bounds_;
+}
+
+void EdgeLayer::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget*)
+{
+    if (lines_.isEmpty()) {
+        return;
+    }
+
+    const qreal detail = option->levelOfDetailFromTransform(painter->worldTransform());
+    const QRectF exposed = option->exposedRect;
+    const bool drawArrows = directed_ && detail * kArrowSize >= kArrowMinPixels;
+    const QColor baseColor = directed_ ? kDirectedEdgeColor : kEdgeColor;
+
+    // Highlighted edges are drawn again on top with a wider pen, so the base pass can include them.
+    visibleLines_.clear();
+    QPainterPath arrowPath;
+    arrowPath.setFillRule(Qt::WindingFill);  // every arrowhead winds the same way, so overlaps stay filled
+    const auto collect = [&](int edge) {
+        const QLineF& line = lines_.at(edge);
+        if (!extentOf(line).intersects(exposed)) {
+            return;
+        }
+        visibleLines_.append(line);
+        if (drawArrows && !qFuzzyIsNull(line.length())) {
+            const Arrow& arrow = arrows_.at(edge);
+            arrowPath.addPolygon(QPolygonF({arrow.tip, arrow.left, arrow.right}));
+            arrowPath.closeSubpath();
+        }
+    };
+
+    // Walk the grid cells under the exposed rect, plus one ring for the pen and arrowhead margin. When that is
+    // more cells than the grid holds (zoomed out, most of the graph on screen) a straight pass is cheaper.
+    if (gridStale_) {
+        rebuildGrid();
+    }
+    const int firstColumn = static_cast<int>(std::floor(exposed.left() / cellSize_)) - 1;
+    const int lastColumn = static_cast<int>(std::floor(exposed.right() / cellSize_)) + 1;
+    const int firstRow = static_cast<int>(std::floor(exposed.top() / cellSize_)) - 1;
+    const int lastRow = static_cast<int>(std::floor(exposed.bottom() / cellSize_)) + 1;
+    const qint64 cellCount = qint64(lastColumn - firstColumn + 1) * (lastRow - firstRow + 1);
+    if (cellCount >= grid_.size()) {
+        for (int edge = 0; edge < lines_.size(); ++edge) {
+            collect(edge);
+        }
+    } else {
+        if (paintMark_.size() != lines_.size() || ++paintEpoch_ == 0) {
+            paintMark_.fill(0, lines_.size());
+            paintEpoch_ = 1;
+        }
+        for (int row = firstRow; row <= lastRow; ++row) {
+            for (int column = firstColumn; column <= lastColumn; ++column) {
+                const auto cell = grid_.constFind(cellKey(column, row));
+                if (cell == grid_.cend()) {
+                    continue;
+                }
+                for (int edge : cell.value()) {
+                    if (paintMark_[edge] != paintEpoch_) {
+                        paintMark_[edge] = paintEpoch_;
+                        collect(edge);
+                    }
+                }
+            }
+        }
+    }
+
+    // Once a 3-unit pen shrinks below a pixel, a cosmetic hairline looks the same and takes the fast raster path.
+    QPen pen(baseColor, detail * kEdgeWidth < 1 ? 0 : kEdgeWidth, Qt::SolidLine, Qt::RoundCap);
+    painter->setPen(pen);
+    painter->drawLines(visibleLines_.constData(), visibleLines_.size());
+    if (!arrowPath.isEmpty()) {
+        painter->fillPath(arrowPath, baseColor);
+    }
+
+    for (auto it = highlights_.cbegin(); it != highlights_.cend(); ++it) {
+        const QLineF& line = lines_.at(it.key());
+        pen.setColor(it.value());
+        pen.setWidthF(kHighlightWidth);
+        painter->setPen(pen);
+        painter->drawLine(line);
+        if (drawArrows && !qFuzzyIsNull(line.length())) {
+            const Arrow& arrow = arrows_.at(it.key());
+            QPainterPath highlightArrow;
+            highlightArrow.addPolygon(QPolygonF({arrow.tip, arrow.left, arrow.right}));
+            highlightArrow.closeSubpath();
+            painter->fillPath(highlightArrow, it.value());
+        }
+    }
+}
+
+quint64 EdgeLayer::cellKey(int column, int row) const
+{
+    return (static_cast<quint64>(static_cast<quint32>(column)) << 32) | static_cast<quint32>(row);
+}
+
+template <typename Visit>
+void EdgeLayer::forEachCell(const QLineF& line, Visit visit) const
+{
+    // Sample the segment every half cell; lookups search the neighboring cells too, which covers corner cuts.
+    // A straight segment visits its cells contiguously, so skipping repeats of the previous key is enough.
+    const int steps = static_cast<int>(std::ceil(line.length() / (cellSize_ / 2))) + 1;
+    quint64 previous = ~quint64(0);
+    for (int step = 0; step <= steps; ++step) {
+        const QPointF point = line.pointAt(static_cast<qreal>(step) / steps);
+        const quint64 key = cellKey(static_cast<int>(std::floor(point.x() / cellSize_)),
+                                    static_cast<int>(std::floor(point.y() / cellSize_)));
+        if (key != previous) {
+            visit(key);
+            previous = key;
+        }
+    }
+}
+
+void EdgeLayer::insertIntoGrid(int edge) const
+{
+    forEachCell(lines_.at(edge), [&](quint64 key) { grid_[key].append(edge); });
+}
+
+void EdgeLayer::eraseFromGrid(int edge) const
+{
+    forEachCell(lines_.at(edge), [&](quint64 key) {
+        auto cell = grid_.find(key);
+        if (cell == grid_.end()) {
+            return;
+        }
+        cell.value().removeOne(edge);
+        if (cell.value().isEmpty()) {
+            grid_.erase(cell);
+        }
+    });
+}
+
+void EdgeLayer::rebuildGrid() const
+{
+    grid_.clear();
+    gridStale_ = false;
+    gridSizedFor_ = lines_.size();
+    if (lines_.isEmpty()) {
+        return;
+    }
+
+    // Size cells from the total edge length so long chords on big rings do not explode into thousands of cells.
+    qreal totalLength = 0;
+    for (const QLineF& line : lines_) {
+        totalLength += line.length();
+    }
+    cellSize_ = qMax(kMinCellSize, totalLength / (lines_.size() * kSamplesPerEdge));
+
+    for (int edge = 0; edge < lines_.size(); ++edge) {
+        insertIntoGrid(edge);
+    }
+}
+
+int EdgeLayer::edgeAt(const QPointF& point, qreal tolerance) const
+{
+    if (gridStale_) {
+        rebuildGrid();
+    }
+    if (grid_.isEmpty()) {
+        return -1;
+    }
+
+    const int column = static_cast<int>(std::floor(point.x() / cellSize_));
+    const int row = static_cast<int>(std::floor(point.y() / cellSize_));
+    const int ring = qBound(1, static_cast<int>(std::ceil(tolerance / cellSize_)), kMaxSearchRing);
+    int best = -1;
+    qreal bestDistance = tolerance;
+    for (int dy = -ring; dy <= ring; ++dy) {
+        for (int dx = -ring; dx <= ring; ++dx) {
+            const auto cell = grid_.constFind(cellKey(column + dx, row + dy));
+            if (cell == grid_.cend()) {
+                continue;
+            }
+            for (int edge : cell.value()) {
+                const qreal distance = distanceToSegment(point, lines_.at(edge));
+                if (distance <= bestDistance) {
+                    bestDistance = distance;
+                    best = edge;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+void EdgeLayer::mousePressEvent(QGraphicsSceneMouseEvent* event)
+{
+    if (!deleteMode_) {
+        event->ignore();  // edges are not clickable outside delete mode: let the view pan
+        return;
+    }
+
+    qreal zoom = 1;
+    if (scene() && !scene()->views().isEmpty()) {
+        zoom = scene()->views().constFirst()->transform().m11();
+    }
+    const qreal tolerance = qMax(kHighlightWidth, kHitPixels / zoom);
+    const int edge = edgeAt(event->pos(), tolerance);
+    if (edge < 0) {
+        event->ignore();  // empty space: let the view pan
+        return;
+    }
+    emit edgeClicked(edge);
+    event->accept();
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QColor>
+#include <QGraphicsObject>
+#include <QHash>
+#include <QLineF>
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+
+class QGraphicsSceneMouseEvent;
+
+// EdgeLayer draws every edge of the canvas as one item. Endpoints live in a flat array indexed like
+// GraphWindow::edges_, arrowheads are computed once per endpoint change, and paint() issues one drawLines and
+// one fillPath for all default-colored edges. A uniform grid over the segments, kept current on every edit,
+// finds both the edges inside the exposed rect and the edge under a click. Clicks are only taken in delete
+// mode; otherwise they fall through to the view so it can pan.
+class EdgeLayer : public QGraphicsObject {
+    Q_OBJECT
+
+public:
+    explicit EdgeLayer(QGraphicsItem* parent = nullptr);
+
+    int count() const { return lines_.size(); }
+    void append(const QPointF& source, const QPointF& target);  // the new edge gets index count() - 1
+    void move(int edge, const QPointF& source, const QPointF& target);  // new endpoints after a node was dragged
+    void removeAt(int edge);  // moves the last edge into the hole, mirroring GraphWindow::removeEdgeAt
+    void clear();
+    void setDirected(bool directed);  // switches the color and the arrowheads for every edge
+    void setDeleteMode(bool enabled);  // while on, clicks on an edge emit edgeClicked instead of reaching the view
+    void highlight(int edge, const QColor& color);  // draw one edge thicker in color until resetHighlights()
+    void resetHighlights();
+    int edgeAt(const QPointF& point, qreal tolerance) const;  // nearest edge within tolerance scene units, -1 if none
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+
+signals:
+    void edgeClicked(int edge);
+
+protected:
+    void mousePressEvent(QGraphicsSceneMouseEvent* event) override;
+
+private:
+    struct Arrow {
+        QPointF tip;
+        QPointF left;
+        QPointF right;
+    };
+
+    Arrow arrowFor(const QLineF& line) const;  // midpoint arrowhead; degenerate for zero-length lines
+    QRectF extentOf(const QLineF& line) const;  // line bounds padded for pen width and arrowhead
+    void growBounds(const QRectF& extent);  // bounds only grow between clear() calls, sparing geometry changes
+    void rebuildGrid() const;
+    void insertIntoGrid(int edge) const;  // file lines_[edge] under every cell it crosses
+    void eraseFromGrid(int edge) const;  // undo insertIntoGrid for the current lines_[edge]
+    template <typename Visit>
+    void forEachCell(const QLineF& line, Visit visit) const;  // each grid cell the segment crosses, once
+    quint64 cellKey(int column, int row) const;
+
+    QVector<QLineF> lines_;  // one entry per edge, scene coordinates
+    QVector<Arrow> arrows_;  // cached arrowheads, parallel to lines_, drawn only while directed_
+    QHash<int, QColor> highlights_;  // animation colors by edge index; usually a handful of entries
+    QRectF bounds_;
+    bool directed_{false};
+    bool deleteMode_{false};
+
+    mutable QHash<quint64, QVector<int>> grid_;  // cell -> edges crossing it
+    mutable qreal cellSize_{1};
+    mutable int gridSizedFor_{0};  // edge count cellSize_ was fitted to; the grid is refitted once it doubles
+    mutable bool gridStale_{true};  // set by clear() and by growth past the fit; edits otherwise update grid_ in place
+    QVector<QLineF> visibleLines_;  // paint() scratch, kept to reuse its capacity
+    QVector<quint32> paintMark_;  // paint() scratch: per-edge stamp so edges spanning several cells are drawn once
+    quint32 paintEpoch_{0};
+};
@@ -0,0 +1,102 @@
+#include "graphview.h"
+
+#include <QKeyEvent>
+#include <QPainter>
+#include <QWheelEvent>
+#include <QtCore/Qt>
+#include <QtGlobal>
+#include <cmath>
+
+namespace {
+constexpr qreal kMaxZoom = 4.0;  // node labels are crisp well before this
+constexpr qreal kWheelStep = 1.0015;  // zoom factor per wheel delta unit, 120 units = ~20%
+constexpr qreal kKeyStep = 1.25;  // zoom factor per +/- key press
+constexpr qreal kAntialiasZoom = 0.35;  // below this, smoothing sub-pixel edges costs frames and shows nothing
+}
+
+GraphView::GraphView(QGraphicsScene* scene, QWidget* parent)
+    : QGraphicsView(scene, parent)
+{
+    setDragMode(QGraphicsView::ScrollHandDrag);  // items still take clicks and drags; empty space pans
+    setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
+    setResizeAnchor(QGraphicsView::AnchorViewCenter);
+    setViewportUpdateMode(QGraphicsView::SmartViewportUpdate);
+    setCacheMode(QGraphicsView::CacheBackground);
+    setOptimizationFlags(QGraphicsView::DontSavePainterState | QGraphicsView::DontAdjustForAntialiasing);
+    setFocusPolicy(Qt::WheelFocus);
+    updateRenderHints();
+}
+
+qreal GraphView::zoom() const
+{
+    return transform().m11();
+}
+
+qreal GraphView::fitZoom() const
+{
+    const QRectF bounds = sceneRect();
+    if (bounds.isEmpty()) {
+        return 1.0;
+    }
+    const QSize area = viewport()->size();
+    return qMin(area.width() / bounds.width(), area.height() / bounds.height());
+}
+
+void GraphView::zoomBy(qreal factor)
+{
+    const qreal minimum = qMin<qreal>(fitZoom() / 2, 1.0);
+    const qreal target = qBound(minimum, zoom() * factor, kMaxZoom);
+    if (qFuzzyCompare(target, zoom())) {
+        return;
+    }
+    scale(target / zoom(), target / zoom());
+    updateRenderHints();
+}
+
+void GraphView::fitGraph()
+{
+    resetTransform();
+    const qreal target = fitZoom();
+    if (target < 1.0) {
+        scale(target, target);
+    }
+    centerOn(sceneRect().center());
+    updateRenderHints();
+}
+
+void GraphView::wheelEvent(QWheelEvent* event)
+{
+    const int delta = event->angleDelta().y();
+    if (delta == 0) {
+        QGraphicsView::wheelEvent(event);  // horizontal wheels keep scrolling
+        return;
+    }
+    zoomBy(std::pow(kWheelStep, delta));
+    event->accept();
+}
+
+void GraphView::keyPressEvent(QKeyEvent* event)
+{
+    switch (event->key()) {
+    case Qt::Key_Plus:
+    case Qt::Key_Equal:
+        zoomBy(kKeyStep);
+        break;
+    case Qt::Key_Minus:
+        zoomBy(1 / kKeyStep);
+        break;
+    case Qt::Key_0:
+        fitGraph();
+        break;
+    default:
+        QGraphicsView::keyPressEvent(event);
+        return;
+    }
+    event->accept();
+}
+
+void GraphView::updateRenderHints()
+{
+    setRenderHint(QPainter::Antialiasing, zoom() >= kAntialiasZoom);
+    setRenderHint(QPainter::TextAntialiasing, zoom() >= kAntialiasZoom);
+}
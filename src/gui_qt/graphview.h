@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QGraphicsView>
+
+class QKeyEvent;
+class QWheelEvent;
+
+// GraphView is the canvas for large graphs: the wheel zooms around the cursor, dragging empty space pans, and the
+// render settings follow the zoom so thousands of nodes stay interactive. Items read the zoom back through
+// QStyleOptionGraphicsItem::levelOfDetailFromTransform() to drop detail on their own.
+class GraphView : public QGraphicsView {
+    Q_OBJECT
+
+public:
+    explicit GraphView(QGraphicsScene* scene, QWidget* parent = nullptr);
+    void zoomBy(qreal factor);  // scale around the viewport anchor, clamped between fitting the scene and kMaxZoom
+    void fitGraph();  // show the whole scene rect, never magnifying past 1:1
+    qreal zoom() const;  // current view scale, 1 = scene pixels
+
+protected:
+    void wheelEvent(QWheelEvent* event) override;
+    void keyPressEvent(QKeyEvent* event) override;
+
+private:
+    qreal fitZoom() const;  // scale at which the whole scene rect fits the viewport
+    void updateRenderHints();  // antialias only while zoomed in far enough for it to show
+};
@@ -1,34 +1,37 @@
 #include "graphwindow.h"
-#include "edgeitem.h"
+#include "edgelayer.h"
+#include "graphview.h"
 #include "nodeitem.h"
 
-#include "Logic/disjoint_set.h"
+#include "Logic/cycle_search.h"
+#include "Logic/graph_io.h"
+#include "Logic/perf_counters.h"
 
 #include <QBrush>
 #include <QColor>
 #include <QButtonGroup>
+#include <QFileDialog>
 #include <QGraphicsScene>
-#include <QGraphicsView>
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QPainter>
+#include <QProgressBar>
+#include <QPromise>
 #include <QPushButton>
 #include <QRadioButton>
 #include <QSpinBox>
 #include <QString>
-#include <QStringList>
-#include <QTextStream>
 #include <QVBoxLayout>
 #include <QtAlgorithms>
 #include <QtCore/Qt>
 #include <QtGlobal>
 #include <QCoreApplication>
-#include <QDateTime>
-#include <QFile>
-#include <QMap>
-#include <QTextStream>
 #include <QTimer>
+#include <QtConcurrent/QtConcurrentRun>
 #include <cmath>
+#include <filesystem>
+#include <memory>
+#include <utility>
 
 namespace {
 constexpr qreal kPi = 3.14159265358979323846;
@@ -46,24 +49,141 @@ const QColor kNodeCycleStroke(255, 51, 102);
 const QColor kEdgeTraverseColor(255, 214, 247);
 const QColor kEdgeCycleColor(255, 82, 175);
 const QColor kEdgeUnionColor(118, 241, 137);
+constexpr qint64 kMaxDrawableEdges = 20000;  // beyond this the scene is unusable; larger files belong in a headless run
+constexpr int kProgressSteps = 1000;  // resolution of the analysis progress bar
+constexpr int kStepBatch = 256;  // animation steps per batch streamed back from the background search
+constexpr int kMaxPendingSteps = 4 * kStepBatch;  // the search pauses once the animation is this far behind
+constexpr qreal kSceneWidth = 1020;  // default canvas, enough for a ring of a few dozen nodes
+constexpr qreal kSceneHeight = 460;
+constexpr qreal kRingMargin = 90;  // space between the node ring and the scene edge
+constexpr qreal kNodeSpacing = 72;  // arc length per node once the ring has to grow, a node diameter plus a gap
+
+// The default canvas for small graphs; larger ones get a square scene whose ring leaves kNodeSpacing per node.
+QRectF sceneRectFor(int vertexCount)
+{
+    const qreal defaultRadius = qMin(kSceneWidth, kSceneHeight) / 2 - kRingMargin;
+    const qreal radius = vertexCount * kNodeSpacing / (2 * kPi);
+    if (radius <= defaultRadius) {
+        return QRectF(0, 0, kSceneWidth, kSceneHeight);
+    }
+    const qreal side = 2 * (radius + kRingMargin);
+    return QRectF(0, 0, side, side);
+}
+
+// Key for an edge exactly as drawn; undirected lookups probe both orientations.
+quint64 drawnEdgeKey(int source, int target)
+{
+    return (static_cast<quint64>(static_cast<quint32>(source)) << 32) | static_cast<quint32>(target);
+}
+
+// Tracer policy that turns the graph's own traversal events into animation steps.
+struct AnimationStepRecorder {
+    QVector<AnimationStep>& steps;
+    qint64 edgesTraversed{0};  // each edge is examined at most once, so this over the edge count is the progress
+
+    void nodeVisited(int node) { steps.append({AnimationStep::Type::NodeVisit, node}); }
+    void edgeTraversed(int source, int target)
+    {
+        ++edgesTraversed;
+        steps.append({AnimationStep::Type::EdgeTraverse, -1, source, target});
+    }
+    void nodeBacktracked(int node) { steps.append({AnimationStep::Type::NodeBacktrack, node}); }
+    void setsMerged(int source, int target) { steps.append({AnimationStep::Type::UnionHighlight, -1, source, target}); }
+    void cycleFound(const CycleWitness& witness)
+    {
+        for (const CycleWitness::Edge& edge : witness.edges) {
+            steps.append({AnimationStep::Type::EdgeCycle, -1, edge.source, edge.target});
+            steps.append({AnimationStep::Type::NodeCycle, edge.target});
+        }
+    }
+};
+
+// Runs on a pool thread against its own graph rebuilt from the copied edges, so the window's graph stays with the
+// GUI thread. Steps go back in batches as the search produces them; the window suspends the future while it is
+// behind, so only a few batches are ever waiting. Cancellation is polled between search steps.
+void analyzeGraph(QPromise<CycleAnalysis>& promise, int vertexCount, bool directed, const std::vector<std::pair<int, int>>& edges)
+{
+    auto graph = std::make_shared<Graph>(vertexCount, directed);
+    graph->addEdges(edges);
+    graph->freeze();  // the search only reads, so walk contiguous arrays
+
+    CycleAnalysis batch;
+    AnimationStepRecorder recorder{batch.steps};
+    CycleSearch search(*graph);
+    const qint64 edgeTotal = qMax<qint64>(graph->edgeCount(), 1);
+    promise.setProgressRange(0, kProgressSteps);
+    while (search.advance(recorder)) {
+        if (batch.steps.size() >= kStepBatch) {
+            promise.addResult(std::move(batch));
+            batch.steps.clear();  // moved-from, but the recorder still appends into this vector
+        }
+        promise.suspendIfRequested();
+        if (promise.isCanceled()) {
+            return;
+        }
+        promise.setProgressValue(static_cast<int>(recorder.edgesTraversed * kProgressSteps / edgeTotal));
+    }
+
+    batch.last = true;
+    batch.witness = search.witness();
+    DetectionRecord& record = batch.logRecord;
+    record.vertexCount = vertexCount;
+    record.cyclic = !batch.witness.isEmpty();
+    graph->components();  // memoize now, so the log writer only reads the graph it is handed
+    record.graph = std::move(graph);
+    promise.setProgressValue(kProgressSteps);
+    promise.addResult(std::move(batch));
+}
+
+DetectionLog::Options detectionLogOptions()
+{
+    DetectionLog::Options options;
+    options.path = std::filesystem::path((QCoreApplication::applicationDirPath() + "/cycle_detection_log.txt").toStdU16String());
+    return options;
+}
+
+// Latency in the largest unit that keeps at least one whole digit.
+QString formatDuration(quint64 nanoseconds)
+{
+    if (nanoseconds < 1000) {
+        return QStringLiteral("%1 ns").arg(nanoseconds);
+    }
+    if (nanoseconds < 1000000) {
+        return QStringLiteral("%1 us").arg(nanoseconds / 1e3, 0, 'f', 1);
+    }
+    if (nanoseconds < 1000000000) {
+        return QStringLiteral("%1 ms").arg(nanoseconds / 1e6, 0, 'f', 1);
+    }
+    return QStringLiteral("%1 s").arg(nanoseconds / 1e9, 0, 'f', 2);
+}
 
 }
 
 GraphWindow::GraphWindow(QWidget* parent)
     : QWidget(parent),
       scene_(new QGraphicsScene(this)),
-      view_(new QGraphicsView(scene_)),
+      view_(new GraphView(scene_)),
       vertexSpin_(new QSpinBox()),
       drawButton_(new QPushButton(tr("Draw Graph"))),
+      loadButton_(new QPushButton(tr("Load Graph"))),
       checkButton_(new QPushButton(tr("Check Cyclic"))),
+      cancelButton_(new QPushButton(tr("Cancel"))),
+      statsButton_(new QPushButton(tr("Stats"))),
       directedRadio_(new QRadioButton(tr("Directed"))),
       undirectedRadio_(new QRadioButton(tr("Undirected"))),
       statusLabel_(new QLabel()),
         resultLabel_(new QLabel()),
+        progressBar_(new QProgressBar()),
+        statsLabel_(new QLabel()),
+        edgeLayer_(new EdgeLayer()),
         deleteEdgeButton_(new QPushButton(tr("Delete Edge"))),
         deleteVertexButton_(new QPushButton(tr("Delete Vertex"))),
-        animationTimer_(new QTimer(this))
+        animationTimer_(new QTimer(this)),
+        statsTimer_(new QTimer(this)),
+        analysisWatcher_(new QFutureWatcher<CycleAnalysis>(this)),
+        detectionLog_(detectionLogOptions())
 {
+    PerfCounters::setTimingEnabled(true);  // the Stats panel reads the histograms; interactive edits can afford the clock
     setWindowTitle(tr("Neon Cycle Explorer"));
     resize(1120, 720);
     setStyleSheet("background-color: #030712; color: #e8f4ff; QLabel { font-size: 14px; } QGroupBox { border: none; }");
@@ -93,6 +213,10 @@ GraphWindow::GraphWindow(QWidget* parent)
     drawButton_->setMinimumWidth(140);
     drawButton_->setStyleSheet("font-size: 18px; background: #181a2a; color: #ff69b4; border-radius: 8px; border: 1px solid #ff69b4;");
     controlRow->addWidget(drawButton_);
+    loadButton_->setMinimumHeight(38);
+    loadButton_->setMinimumWidth(140);
+    loadButton_->setStyleSheet("font-size: 18px; background: #181a2a; color: #ff69b4; border-radius: 8px; border: 1px solid #ff69b4;");
+    controlRow->addWidget(loadButton_);
 
     auto* radioGroup = new QButtonGroup(this);
     radioGroup->addButton(undirectedRadio_);
@@ -127,15 +251,20 @@ GraphWindow::GraphWindow(QWidget* parent)
     deleteVertexButton_->setMinimumWidth(140);
     deleteVertexButton_->setStyleSheet("font-size: 18px; background: #2a142a; color: #ff9ec7; border-radius: 8px; border: 1px solid #ff69b4;");
     controlRow->addWidget(deleteVertexButton_);
+
+    statsButton_->setCheckable(true);
+    statsButton_->setMinimumHeight(38);
+    statsButton_->setMinimumWidth(100);
+    statsButton_->setStyleSheet("font-size: 18px; background: #181a2a; color: #ff69b4; border-radius: 8px; border: 1px solid #ff69b4;");
+    controlRow->addWidget(statsButton_);
     controlRow->addStretch();
 
     mainLayout->addLayout(controlRow);
 
-    view_->setRenderHint(QPainter::Antialiasing, true);
     view_->setStyleSheet("border-radius: 24px; background: #02040c; border: 1px solid #1d2b47;");
     view_->setMinimumHeight(460);
-    view_->setDragMode(QGraphicsView::NoDrag);
-    scene_->setSceneRect(0, 0, 1020, 460);
+    scene_->setSceneRect(sceneRectFor(0));
+    scene_->addItem(edgeLayer_);  // lives for the whole window; scenes are reset by clearing it
     scene_->setBackgroundBrush(QBrush(QColor(2, 5, 18)));
 
     mainLayout->addWidget(view_);
@@ -144,17 +273,46 @@ GraphWindow::GraphWindow(QWidget* parent)
     statusLabel_->setText(tr("Configure the graph and start drawing edges."));
     mainLayout->addWidget(statusLabel_);
 
+    auto* progressRow = new QHBoxLayout();
+    progressRow->setSpacing(12);
+    progressBar_->setRange(0, kProgressSteps);
+    progressBar_->setTextVisible(false);
+    progressBar_->setFixedHeight(10);
+    progressBar_->setStyleSheet("QProgressBar { background: #181a2a; border: 1px solid #1d2b47; border-radius: 5px; }"
+                                "QProgressBar::chunk { background: #ff69b4; border-radius: 5px; }");
+    progressBar_->hide();
+    progressRow->addWidget(progressBar_, 1);
+    cancelButton_->setMinimumHeight(32);
+    cancelButton_->setMinimumWidth(120);
+    cancelButton_->setStyleSheet("font-size: 16px; background: #2a142a; color: #ff9ec7; border-radius: 8px; border: 1px solid #ff69b4;");
+    cancelButton_->hide();
+    progressRow->addWidget(cancelButton_);
+    mainLayout->addLayout(progressRow);
+
     resultLabel_->setAlignment(Qt::AlignCenter);
     resultLabel_->setFixedHeight(80);
     applyResultStyle(kInfoStyle);
     resultLabel_->setText(tr("Waiting for your graph...").toUpper());
     mainLayout->addWidget(resultLabel_);
 
+    statsLabel_->setTextFormat(Qt::PlainText);
+    statsLabel_->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    statsLabel_->setStyleSheet("font-family: monospace; font-size: 13px; color: #9ad8ff; background: #0b1020; "
+                               "border: 1px solid #1d2b47; border-radius: 10px; padding: 10px;");
+    statsLabel_->hide();
+    mainLayout->addWidget(statsLabel_);
+
     connect(drawButton_, &QPushButton::clicked, this, &GraphWindow::drawGraph);
+    connect(loadButton_, &QPushButton::clicked, this, &GraphWindow::loadGraphFile);
     connect(checkButton_, &QPushButton::clicked, this, &GraphWindow::checkForCycle);
+    connect(cancelButton_, &QPushButton::clicked, this, &GraphWindow::cancelAnimation);
+    connect(edgeLayer_, &EdgeLayer::edgeClicked, this, &GraphWindow::handleEdgeClicked);
+    connect(analysisWatcher_, &QFutureWatcher<CycleAnalysis>::progressValueChanged, progressBar_, &QProgressBar::setValue);
+    connect(analysisWatcher_, &QFutureWatcher<CycleAnalysis>::resultReadyAt, this, &GraphWindow::analysisBatchReady);
     connect(directedRadio_, &QRadioButton::toggled, this, &GraphWindow::onDirectionChanged);
     connect(undirectedRadio_, &QRadioButton::toggled, this, &GraphWindow::onDirectionChanged);
     connect(deleteEdgeButton_, &QPushButton::toggled, this, [this](bool checked) {
+        edgeLayer_->setDeleteMode(checked);
         updateStatus(checked ? tr("Delete mode active. Click an edge to remove it.") : tr("Delete mode off."));
         if (checked) {
             deleteVertexButton_->setChecked(false);
@@ -168,10 +326,27 @@ GraphWindow::GraphWindow(QWidget* parent)
     });
     animationTimer_->setInterval(450);
     connect(animationTimer_, &QTimer::timeout, this, &GraphWindow::advanceAnimationStep);
+    statsTimer_->setInterval(1000);
+    connect(statsTimer_, &QTimer::timeout, this, &GraphWindow::refreshStats);
+    connect(statsButton_, &QPushButton::toggled, this, [this](bool checked) {
+        statsLabel_->setVisible(checked);
+        if (checked) {
+            refreshStats();
+            statsTimer_->start();
+        } else {
+            statsTimer_->stop();
+        }
+    });
 
     // Do not draw anything at startup
 }
 
+GraphWindow::~GraphWindow()
+{
+    analysisWatcher_->cancel();  // a suspended search would otherwise keep the thread pool from shutting down
+    analysisWatcher_->waitForFinished();
+}
+
 void GraphWindow::drawGraph()
 {
     const int count = vertexSpin_->value();
@@ -183,13 +358,63 @@ void GraphWindow::drawGraph()
     deleteEdgeButton_->setChecked(false);
     deleteVertexButton_->setChecked(false);
     clearAnimationHighlights();
-    animationSteps_.clear();
+    pendingSteps_.clear();
     animationDetectedCycle_ = false;
+    cycleWitness_ = CycleWitness();
 
     resetScene(count);
     updateStatus(tr("Nodes placed. Select two to draw edges."));
 }
 
+void GraphWindow::loadGraphFile()
+{
+    if (animationRunning_) {
+        updateStatus(tr("Wait for the animation to finish."), "warning");
+        return;
+    }
+
+    const QString path = QFileDialog::getOpenFileName(this, tr("Load Graph"), QString(),
+                                                      tr("Edge lists (*.txt *.edges *.el *.col *.gr *.dimacs);;All files (*)"));
+    if (path.isEmpty()) {
+        return;
+    }
+
+    // The import runs on the GUI thread, so the drawable size is enforced while reading: an oversized file is
+    // rejected once its pre-scan crosses the limit instead of being streamed in full first.
+    Graph loaded;
+    GraphImporter importer;
+    importer.setSizeLimit(vertexSpin_->maximum(), kMaxDrawableEdges);
+    if (!importer.load(std::filesystem::path(path.toStdU16String()), isDirected_, loaded)) {
+        if (importer.getLastError() == GraphError::GraphTooLarge) {
+            updateStatus(tr("More than %1 vertices or %2 edges are too many to draw.").arg(vertexSpin_->maximum()).arg(kMaxDrawableEdges), "warning");
+        } else {
+            updateStatus(QString::fromUtf8(errorMessage(importer.getLastError())), "warning");
+        }
+        return;
+    }
+
+    deleteEdgeButton_->setChecked(false);
+    deleteVertexButton_->setChecked(false);
+    clearAnimationHighlights();
+    pendingSteps_.clear();
+    animationDetectedCycle_ = false;
+    cycleWitness_ = CycleWitness();
+
+    vertexSpin_->setValue(loaded.vertexCount());
+    resetScene(loaded.vertexCount());
+    for (int vertex = 0; vertex < loaded.vertexCount(); ++vertex) {
+        for (int neighbor : loaded.neighbors(vertex)) {
+            if (isDirected_ || vertex <= neighbor) {  // undirected edges are stored under both endpoints
+                createEdge(vertex, neighbor);
+            }
+        }
+    }
+
+    updateStatus(tr("Loaded %1 edges (%2 lines skipped). Tap Check Cyclic when ready.")
+                     .arg(importer.edgesAdded())
+                     .arg(importer.linesSkipped()));
+}
+
 void GraphWindow::exitDeleteMode()
 {
     if (deleteEdgeButton_->isChecked()) {
@@ -207,7 +432,7 @@ void GraphWindow::resetScene(int vertexCount)
     clearSceneContent();
     nodeMoved(-1);
 
-    scene_->setSceneRect(0, 0, 1020, 460);
+    scene_->setSceneRect(sceneRectFor(vertexCount));
     graph_.configure(vertexCount, isDirected_);
 
     for (int index = 0; index < vertexCount; ++index) {
@@ -217,8 +442,10 @@ void GraphWindow::resetScene(int vertexCount)
         connect(node, &NodeItem::clicked, this, &GraphWindow::nodeClicked);
         connect(node, &NodeItem::moved, this, &GraphWindow::nodeMoved);
     }
+    incidentEdges_.resize(vertexCount);
 
     layoutNodes();
+    view_->fitGraph();
     updateStatus(tr("Tap two nodes to draw an edge."));
     resultLabel_->setText(tr("Awaiting connections...").toUpper());
     applyResultStyle(kInfoStyle);
@@ -226,10 +453,10 @@ void GraphWindow::resetScene(int vertexCount)
 
 void GraphWindow::clearSceneContent()
 {
-    for (EdgeRecord& record : edges_) {
-        delete record.item;
-    }
+    edgeLayer_->clear();
     edges_.clear();
+    edgeLookup_.clear();
+    incidentEdges_.clear();
     qDeleteAll(nodes_);
     nodes_.clear();
     graph_.configure(0, false);
@@ -243,7 +470,7 @@ void GraphWindow::layoutNodes()
 
     const QRectF bounds = scene_->sceneRect();
     const QPointF center = bounds.center();
-    const qreal radius = qMin(bounds.width(), bounds.height()) / 2 - 90;
+    const qreal radius = qMin(bounds.width(), bounds.height()) / 2 - kRingMargin;
 
     for (int index = 0; index < nodes_.size(); ++index) {
         const qreal theta = (static_cast<qreal>(index) / nodes_.size()) * 2 * kPi;
@@ -252,8 +479,8 @@ void GraphWindow::layoutNodes()
         nodes_.at(index)->setPos(x, y);
     }
 
-    for (EdgeRecord& record : edges_) {
-        record.item->updatePosition();
+    for (int index = 0; index < edges_.size(); ++index) {
+        placeEdge(index);
     }
 }
 
@@ -270,30 +497,78 @@ void GraphWindow::checkForCycle()
 
     exitDeleteMode();
 
-    animationSteps_.clear();
-    animationStepIndex_ = 0;
-    prepareAnimationSteps();
-    animationDetectedCycle_ = graph_.detectCycle();
-    logCycleDetection();
+    // Hand the worker a copy of the edges; the graph itself is not thread-safe and stays with the GUI.
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(static_cast<std::size_t>(graph_.edgeCount()));
+    for (int vertex = 0; vertex < vertexCount_; ++vertex) {
+        for (int neighbor : graph_.neighbors(vertex)) {
+            if (isDirected_ || vertex <= neighbor) {  // undirected edges are stored under both endpoints
+                edges.push_back({vertex, neighbor});
+            }
+        }
+    }
+
+    cycleWitness_ = CycleWitness();
+    pendingLogRecord_ = DetectionRecord();
+    pendingSteps_.clear();
+    analysisDone_ = false;
     animationRunning_ = true;
     drawButton_->setEnabled(false);
+    loadButton_->setEnabled(false);
     checkButton_->setEnabled(false);
     deleteEdgeButton_->setEnabled(false);
     deleteVertexButton_->setEnabled(false);
+    progressBar_->setValue(0);
+    progressBar_->show();
+    cancelButton_->show();
     resultLabel_->setText(tr("Analyzing...").toUpper());
     applyResultStyle(kInfoStyle);
-    animationTimer_->start();
-    updateStatus(tr("Animating cycle detection..."));
+    updateStatus(tr("Analyzing the graph in the background..."));
+    analysisWatcher_->setFuture(QtConcurrent::run(analyzeGraph, vertexCount_, isDirected_, std::move(edges)));
+}
+
+void GraphWindow::analysisBatchReady(int index)
+{
+    QFuture<CycleAnalysis> future = analysisWatcher_->future();
+    if (!animationRunning_ || future.isCanceled()) {
+        return;  // cancelled; cancelAnimation() already restored the window
+    }
+
+    CycleAnalysis batch = future.resultAt(index);
+    for (const AnimationStep& step : std::as_const(batch.steps)) {
+        pendingSteps_.enqueue(step);
+    }
+    if (batch.last) {
+        cycleWitness_ = std::move(batch.witness);
+        pendingLogRecord_ = std::move(batch.logRecord);
+        analysisDone_ = true;
+        progressBar_->hide();
+    } else if (pendingSteps_.size() >= kMaxPendingSteps) {
+        analysisWatcher_->suspend();  // advanceAnimationStep() resumes the search once the queue drains
+    }
+
+    if (!animationTimer_->isActive()) {
+        animationTimer_->start();
+        updateStatus(tr("Animating cycle detection..."));
+        advanceAnimationStep();
+    }
 }
 
 void GraphWindow::advanceAnimationStep()
 {
-    if (animationStepIndex_ >= animationSteps_.size()) {
-        finalizeAnimation();
-        return;
+    ScopedPerfTimer timer(PerfOp::AnimationFrame);
+    if (pendingSteps_.isEmpty()) {
+        if (analysisDone_) {
+            finalizeAnimation();
+        }
+        return;  // otherwise the search is still producing the next batch
+    }
+    const AnimationStep step = pendingSteps_.dequeue();
+    const bool paused = analysisWatcher_->isSuspending() || analysisWatcher_->isSuspended();
+    if (paused && pendingSteps_.size() < kStepBatch) {
+        analysisWatcher_->resume();  // let the search refill the queue before it runs dry
     }
 
-    const AnimationStep step = animationSteps_.at(animationStepIndex_++);
     clearAnimationHighlights();
 
     switch (step.type) {
@@ -316,15 +591,11 @@ void GraphWindow::advanceAnimationStep()
         if (step.target >= 0 && step.target < nodes_.size()) {
             nodes_.at(step.target)->highlight(kNodeVisitFill, kNodeVisitStroke);
         }
-        if (EdgeItem* edge = findEdge(step.source, step.target)) {
-            edge->highlight(kEdgeTraverseColor);
-        }
+        edgeLayer_->highlight(findEdge(step.source, step.target), kEdgeTraverseColor);
         updateStatus(tr("Exploring edge %1 → %2.").arg(step.source + 1).arg(step.target + 1));
         break;
     case AnimationStep::Type::EdgeCycle:
-        if (EdgeItem* edge = findEdge(step.source, step.target)) {
-            edge->highlight(kEdgeCycleColor);
-        }
+        edgeLayer_->highlight(findEdge(step.source, step.target), kEdgeCycleColor);
         updateStatus(tr("Cycle edge spotted between %1 and %2.").arg(step.source + 1).arg(step.target + 1));
         break;
     case AnimationStep::Type::NodeCycle:
@@ -340,9 +611,7 @@ void GraphWindow::advanceAnimationStep()
         if (step.target >= 0 && step.target < nodes_.size()) {
             nodes_.at(step.target)->highlight(kNodeVisitFill, kNodeVisitStroke);
         }
-        if (EdgeItem* edge = findEdge(step.source, step.target)) {
-            edge->highlight(kEdgeUnionColor);
-        }
+        edgeLayer_->highlight(findEdge(step.source, step.target), kEdgeUnionColor);
         updateStatus(tr("Merging sets for edge %1 → %2.").arg(step.source + 1).arg(step.target + 1));
         break;
     }
@@ -351,8 +620,13 @@ void GraphWindow::advanceAnimationStep()
 void GraphWindow::finalizeAnimation()
 {
     animationTimer_->stop();
+    pendingSteps_.clear();
     animationRunning_ = false;
+    animationDetectedCycle_ = !cycleWitness_.isEmpty();
+    logCycleDetection();
+    cancelButton_->hide();
     drawButton_->setEnabled(true);
+    loadButton_->setEnabled(true);
     checkButton_->setEnabled(true);
     deleteEdgeButton_->setEnabled(true);
     deleteVertexButton_->setEnabled(true);
@@ -361,7 +635,31 @@ void GraphWindow::finalizeAnimation()
     updateResultLabel(animationDetectedCycle_ ? tr("Cycle detected in the current graph.")
                                               : tr("Graph is acyclic."),
                       animationDetectedCycle_);
-    updateStatus(animationDetectedCycle_ ? tr("Cycle detected.") : tr("No cycles found."));
+    const QString logNotice = logDropNotice();
+    updateStatus((animationDetectedCycle_ ? tr("Cycle detected.") : tr("No cycles found.")) + logNotice,
+                 logNotice.isEmpty() ? "info" : "warning");
+}
+
+void GraphWindow::cancelAnimation()
+{
+    if (!animationRunning_) {
+        return;
+    }
+
+    analysisWatcher_->cancel();  // no-op once the background search has finished; also wakes a suspended search
+    animationTimer_->stop();
+    pendingSteps_.clear();  // the search stops at its next poll, so the steps it never produced are never computed
+    animationRunning_ = false;
+    progressBar_->hide();
+    cancelButton_->hide();
+    drawButton_->setEnabled(true);
+    loadButton_->setEnabled(true);
+    checkButton_->setEnabled(true);
+    deleteEdgeButton_->setEnabled(true);
+    deleteVertexButton_->setEnabled(true);
+    clearAnimationHighlights();
+    resultLabel_->setText(tr("Check cancelled.").toUpper());
+    applyResultStyle(kInfoStyle);
 }
 
 void GraphWindow::clearAnimationHighlights()
@@ -369,144 +667,88 @@ void GraphWindow::clearAnimationHighlights()
     for (NodeItem* node : nodes_) {
         node->resetAppearance();
     }
-    for (EdgeRecord& record : edges_) {
-        record.item->resetAppearance();
-    }
+    edgeLayer_->resetHighlights();
 }
 
 void GraphWindow::applyFinalCycleHighlights()
 {
-    for (const AnimationStep& step : animationSteps_) {
-        if (step.type == AnimationStep::Type::EdgeCycle) {
-            if (EdgeItem* edge = findEdge(step.source, step.target)) {
-                edge->highlight(kEdgeCycleColor);
-            }
-        }
-        if (step.type == AnimationStep::Type::NodeCycle && step.node >= 0 && step.node < nodes_.size()) {
-            nodes_.at(step.node)->highlight(kNodeCycleFill, kNodeCycleStroke);
+    for (const CycleWitness::Edge& cycleEdge : cycleWitness_.edges) {
+        edgeLayer_->highlight(findEdge(cycleEdge.source, cycleEdge.target), kEdgeCycleColor);
+    }
+    for (int node : cycleWitness_.vertices) {
+        if (node >= 0 && node < nodes_.size()) {
+            nodes_.at(node)->highlight(kNodeCycleFill, kNodeCycleStroke);
         }
     }
 }
 
-bool GraphWindow::prepareAnimationSteps()
+int GraphWindow::findEdge(int source, int target) const
 {
-    if (vertexCount_ <= 0) {
-        return false;
+    int index = edgeLookup_.value(drawnEdgeKey(source, target), -1);
+    if (index < 0 && !isDirected_) {
+        index = edgeLookup_.value(drawnEdgeKey(target, source), -1);
     }
-
-    animationSteps_.clear();
-
-    if (isDirected_) {
-        QVector<bool> visited(vertexCount_, false);
-        QVector<bool> recursionStack(vertexCount_, false);
-        for (int vertex = 0; vertex < vertexCount_; ++vertex) {
-            if (!visited[vertex]) {
-                if (collectDirectedSteps(vertex, visited, recursionStack)) {
-                    break;
-                }
-            }
-        }
-    } else {
-        collectUndirectedSteps();
-    }
-
-    return !animationSteps_.isEmpty();
+    return index;
 }
 
-bool GraphWindow::collectDirectedSteps(int vertex, QVector<bool>& visited, QVector<bool>& recursionStack)
+void GraphWindow::placeEdge(int index)
 {
-    auto adjacency = graph_.getAdjacencyList();
-    animationSteps_.append({AnimationStep::Type::NodeVisit, vertex});
-    visited[vertex] = true;
-    recursionStack[vertex] = true;
-
-    for (int neighbor : adjacency[vertex]) {
-        animationSteps_.append({AnimationStep::Type::EdgeTraverse, -1, vertex, neighbor});
-        if (!visited[neighbor]) {
-            if (collectDirectedSteps(neighbor, visited, recursionStack)) {
-                animationSteps_.append({AnimationStep::Type::EdgeCycle, -1, vertex, neighbor});
-                animationSteps_.append({AnimationStep::Type::NodeCycle, neighbor});
-                return true;
-            }
-        } else if (recursionStack[neighbor]) {
-            animationSteps_.append({AnimationStep::Type::EdgeCycle, -1, vertex, neighbor});
-            animationSteps_.append({AnimationStep::Type::NodeCycle, neighbor});
-            return true;
-        }
-    }
-
-    recursionStack[vertex] = false;
-    animationSteps_.append({AnimationStep::Type::NodeBacktrack, vertex});
-    return false;
+    const EdgeRecord& record = edges_.at(index);
+    edgeLayer_->move(index, nodes_.at(record.source)->pos(), nodes_.at(record.target)->pos());
 }
 
-bool GraphWindow::collectUndirectedSteps()
+void GraphWindow::removeEdgeAt(int index)
 {
-    auto adjacency = graph_.getAdjacencyList();
-    DisjointSet set(vertexCount_);
-
-    for (int source = 0; source < vertexCount_; ++source) {
-        for (int target : adjacency[source]) {
-            if (source >= target) {
-                continue;
-            }
-
-            animationSteps_.append({AnimationStep::Type::EdgeTraverse, -1, source, target});
-            const int rootSource = set.find(source);
-            const int rootTarget = set.find(target);
-
-            if (rootSource == rootTarget) {
-                animationSteps_.append({AnimationStep::Type::EdgeCycle, -1, source, target});
-                animationSteps_.append({AnimationStep::Type::NodeCycle, target});
-                return true;
+    const EdgeRecord record = edges_.at(index);
+    edgeLookup_.remove(drawnEdgeKey(record.source, record.target));
+    incidentEdges_[record.source].removeOne(index);
+    if (record.target != record.source) {
+        incidentEdges_[record.target].removeOne(index);
+    }
+
+    // Swap the last record into the hole so removal stays O(1); the edge layer does the same with its arrays.
+    const int last = edges_.size() - 1;
+    if (index != last) {
+        const EdgeRecord moved = edges_.at(last);
+        edges_[index] = moved;
+        edgeLookup_.insert(drawnEdgeKey(moved.source, moved.target), index);
+        const auto renumber = [last, index](QVector<int>& incident) {
+            const int slot = incident.indexOf(last);
+            if (slot >= 0) {
+                incident[slot] = index;
             }
-
-            set.unionSets(rootSource, rootTarget);
-            animationSteps_.append({AnimationStep::Type::UnionHighlight, -1, source, target});
+        };
+        renumber(incidentEdges_[moved.source]);
+        if (moved.target != moved.source) {
+            renumber(incidentEdges_[moved.target]);
         }
     }
+    edges_.removeLast();
+    edgeLayer_->removeAt(index);
 
-    return false;
-}
-
-EdgeItem* GraphWindow::findEdge(int source, int target) const
-{
-    for (const EdgeRecord& record : edges_) {
-        if (record.source == source && record.target == target) {
-            return record.item;
-        }
-        if (!isDirected_ && record.source == target && record.target == source) {
-            return record.item;
-        }
+    // Edges drawn both ways in directed mode stay two records after a switch to undirected, but the graph
+    // rejects the reversed duplicate and holds one edge for both. Keep it while the reversed record is drawn.
+    if (isDirected_ || !edgeLookup_.contains(drawnEdgeKey(record.target, record.source))) {
+        graph_.removeEdge(record.source, record.target);
     }
-    return nullptr;
 }
 
-int GraphWindow::findEdgeIndex(EdgeItem* edge) const
+void GraphWindow::rebuildEdgeLookup()
 {
+    edgeLookup_.clear();
+    edgeLookup_.reserve(edges_.size());
     for (int index = 0; index < edges_.size(); ++index) {
-        if (edges_.at(index).item == edge) {
-            return index;
-        }
+        edgeLookup_.insert(drawnEdgeKey(edges_.at(index).source, edges_.at(index).target), index);
     }
-    return -1;
 }
 
-void GraphWindow::handleEdgeClicked(EdgeItem* edge)
+void GraphWindow::handleEdgeClicked(int index)
 {
-    if (!edge || !deleteEdgeButton_->isChecked() || animationRunning_) {
-        return;
-    }
-
-    const int index = findEdgeIndex(edge);
-    if (index < 0) {
+    if (index < 0 || index >= edges_.size() || !deleteEdgeButton_->isChecked() || animationRunning_) {
         return;
     }
 
-    const EdgeRecord record = edges_.takeAt(index);
-    graph_.removeEdge(record.source, record.target);
-    scene_->removeItem(record.item);
-    record.item->deleteLater();
+    removeEdgeAt(index);
     updateStatus(tr("Edge removed. Run a cycle check to see the updated graph."));
     resultLabel_->setText(tr("Edge removed.").toUpper());
     applyResultStyle(kInfoStyle);
@@ -521,16 +763,11 @@ void GraphWindow::deleteVertex(int index)
         return;
     }
 
-    // Remove incident edges first.
-    for (int i = edges_.size() - 1; i >= 0; --i) {
-        const EdgeRecord& record = edges_.at(i);
-        if (record.source == index || record.target == index) {
-            EdgeRecord removed = edges_.takeAt(i);
-            graph_.removeEdge(removed.source, removed.target);
-            scene_->removeItem(removed.item);
-            removed.item->deleteLater();
-        }
+    // Remove incident edges first; removeEdgeAt shrinks the list and renumbers swapped edges as it goes.
+    while (!incidentEdges_.at(index).isEmpty()) {
+        removeEdgeAt(incidentEdges_.at(index).constLast());
     }
+    incidentEdges_.removeAt(index);
 
     NodeItem* node = nodes_.takeAt(index);
     scene_->removeItem(node);
@@ -560,17 +797,15 @@ void GraphWindow::reindexAfterVertexRemoval(int removedIndex)
         if (record.target > removedIndex) {
             --record.target;
         }
-        record.item->updatePosition();
     }
+    rebuildEdgeLookup();  // endpoint indices shifted, so every key above removedIndex changed
 }
 
 void GraphWindow::onDirectionChanged()
 {
+    cancelAnimation();  // a running check would report on the old edge directions
     isDirected_ = directedRadio_->isChecked();
-    for (EdgeRecord& record : edges_) {
-        record.item->setDirected(isDirected_);
-        record.item->updatePosition();
-    }
+    edgeLayer_->setDirected(isDirected_);
 
     synchronizeGraphEdges();
     updateStatus(isDirected_ ? tr("Running directed checks.") : tr("Running undirected checks."));
@@ -612,21 +847,32 @@ void GraphWindow::nodeClicked(int index)
     selectedNode_ = nullptr;
 }
 
-void GraphWindow::nodeMoved(int)
+void GraphWindow::nodeMoved(int index)
 {
-    for (EdgeRecord& record : edges_) {
-        record.item->updatePosition();
+    if (index < 0 || index >= incidentEdges_.size()) {
+        for (int edge = 0; edge < edges_.size(); ++edge) {
+            placeEdge(edge);
+        }
+        return;
+    }
+
+    // Only the edges touching the dragged node change shape.
+    for (int edge : incidentEdges_.at(index)) {
+        placeEdge(edge);
     }
 }
 
 void GraphWindow::createEdge(int source, int target)
 {
     if (!edgeAlreadyExists(source, target)) {
-        auto* edge = new EdgeItem(nodes_.at(source), nodes_.at(target), isDirected_);
-        scene_->addItem(edge);
-        edge->setAcceptedMouseButtons(Qt::LeftButton);
-        connect(edge, &EdgeItem::clicked, this, &GraphWindow::handleEdgeClicked);
-        edges_.append({edge, source, target});
+        const int index = edges_.size();
+        edgeLayer_->append(nodes_.at(source)->pos(), nodes_.at(target)->pos());
+        edgeLookup_.insert(drawnEdgeKey(source, target), index);
+        edges_.append({source, target});
+        incidentEdges_[source].append(index);
+        if (target != source) {
+            incidentEdges_[target].append(index);
+        }
         graph_.addEdge(source, target);
         updateStatus(tr("Edge drawn. Drag nodes to reshape the drawing."));
         resultLabel_->setText(tr("Tap Check Cyclic when ready.").toUpper());
@@ -638,33 +884,16 @@ void GraphWindow::createEdge(int source, int target)
 
 bool GraphWindow::edgeAlreadyExists(int source, int target) const
 {
-    for (const EdgeRecord& record : edges_) {
-        if (isDirected_) {
-            if (record.source == source && record.target == target) {
-                return true;
-            }
-        } else if ((record.source == source && record.target == target) ||
-                   (record.source == target && record.target == source)) {
-            return true;
-        }
-    }
-
-    return false;
+    return findEdge(source, target) >= 0;
 }
 
 void GraphWindow::synchronizeGraphEdges()
 {
+    ScopedPerfTimer timer(PerfOp::SynchronizeEdges);
     graph_.configure(vertexCount_, isDirected_);
-    // Only add edges that match the current direction mode and visual direction
+    // Each drawn edge is added once; an undirected Graph already stores both directions.
     for (const EdgeRecord& record : edges_) {
-        if (isDirected_) {
-            // Only add the edge as drawn (source -> target)
-            graph_.addEdge(record.source, record.target);
-        } else {
-            // For undirected, add both directions (if not already present)
-            graph_.addEdge(record.source, record.target);
-            graph_.addEdge(record.target, record.source);
-        }
+        graph_.addEdge(record.source, record.target);
     }
 }
 
@@ -699,57 +928,41 @@ void GraphWindow::logCycleDetection()
         return;
     }
 
-    const QString logPath = QCoreApplication::applicationDirPath() + "/cycle_detection_log.txt";
-    QFile file(logPath);
-    if (!file.open(QIODevice::Append | QIODevice::Text)) {
-        return;
-    }
-
-    QTextStream stream(&file);
-    if (file.size() == 0) {
-        stream << "**CYCLE DETECTION**\n\n";
-    }
-
-    stream << "--------------------------------------------\n";
-    stream << tr("Timestamp: %1\n").arg(QDateTime::currentDateTime().toString(Qt::ISODate));
-    stream << tr("Vertex count: %1\n").arg(vertexCount_);
-    stream << tr("Cycle detected: %1\n").arg(animationDetectedCycle_ ? tr("Yes") : tr("No"));
-    stream << "Sets:\n";
-
-    auto adjacency = graph_.getAdjacencyList();
-    DisjointSet disjointSet(vertexCount_);
-    for (int source = 0; source < adjacency.size(); ++source) {
-        for (int target : adjacency[source]) {
-            const int rootSource = disjointSet.find(source);
-            const int rootTarget = disjointSet.find(target);
-            disjointSet.unionSets(rootSource, rootTarget);
-        }
-    }
-
-    QMap<int, QVector<int>> clusters;
-    for (int vertex = 0; vertex < vertexCount_; ++vertex) {
-        const int root = disjointSet.find(vertex);
-        clusters[root].append(vertex);
-    }
-
-    int setIndex = 1;
-    for (auto it = clusters.cbegin(); it != clusters.cend(); ++it, ++setIndex) {
-        const QVector<int>& members = it.value();
-        QStringList memberNames;
-        for (int vertex : members) {
-            memberNames << QString::number(vertex);
-        }
-        stream << tr("  Set %1: %2\n").arg(setIndex).arg(memberNames.isEmpty() ? tr("None") : memberNames.join(", "));
-    }
+    // The record was assembled by the background search; formatting and file I/O happen on the writer thread.
+    detectionLog_.submit(std::move(pendingLogRecord_));
+    pendingLogRecord_ = DetectionRecord();
+}
 
-    stream << "Vertices:\n";
-    for (int vertex = 0; vertex < adjacency.size(); ++vertex) {
-        QStringList neighbors;
-        for (int neighbor : adjacency[vertex]) {
-            neighbors << QString::number(neighbor);
-        }
-        stream << tr("  Vertex %1: %2\n").arg(vertex).arg(neighbors.isEmpty() ? tr("None") : neighbors.join(", "));
+QString GraphWindow::logDropNotice()
+{
+    // Drops by the writer thread show up here one check late at worst; the stats panel shows the running total.
+    const quint64 dropped = detectionLog_.dropped();
+    if (dropped == reportedLogDrops_) {
+        return QString();
     }
+    reportedLogDrops_ = dropped;
+    return tr(" %n log entries could not be written so far.", nullptr, static_cast<int>(dropped));
+}
 
-    stream << "\n";
+void GraphWindow::refreshStats()
+{
+    const PerfCounters& counters = PerfCounters::instance();
+    QString text = QStringLiteral("%1 %2 %3 %4 %5\n").arg(tr("operation"), -18).arg(tr("calls"), 9).arg(tr("p50"), 10)
+                       .arg(tr("p99"), 10).arg(tr("max"), 10);
+    for (int index = 0; index < static_cast<int>(PerfOp::Count); ++index) {
+        const PerfOp op = static_cast<PerfOp>(index);
+        const LatencyHistogram& histogram = counters.histogram(op);
+        text += QStringLiteral("%1 %2 %3 %4 %5\n")
+                    .arg(QString::fromUtf8(perfOpName(op)), -18)
+                    .arg(histogram.count(), 9)
+                    .arg(formatDuration(histogram.percentile(0.5)), 10)
+                    .arg(formatDuration(histogram.percentile(0.99)), 10)
+                    .arg(formatDuration(histogram.maxNanoseconds()), 10);
+    }
+    text += tr("adjacency %1 KiB (peak %2 KiB), process peak RSS %3 KiB, log entries dropped %4")
+                .arg(counters.adjacencyBytes() / 1024)
+                .arg(counters.peakAdjacencyBytes() / 1024)
+                .arg(PerfCounters::peakResidentKb())
+                .arg(detectionLog_.dropped());
+    statsLabel_->setText(text);
 }
@@ -1,18 +1,24 @@
 #pragma once
 
+#include "Logic/detection_log.h"
 #include "Logic/graph.h"
 
+#include <QFutureWatcher>
+#include <QHash>
+#include <QQueue>
 #include <QWidget>
 #include <QVector>
+#include <vector>
 
-class EdgeItem;
+class EdgeLayer;
+class GraphView;
 class NodeItem;
 class QButtonGroup;
 class QGraphicsScene;
-class QGraphicsView;
 class QPushButton;
 class QRadioButton;
 class QLabel;
+class QProgressBar;
 class QSpinBox;
 class QTimer;
 
@@ -25,8 +31,15 @@ struct AnimationStep {
 };
 struct AnimationStep;
 
+// One batch streamed back by a background check. Batches arrive in search order; the last one also carries the answers.
+struct CycleAnalysis {
+    QVector<AnimationStep> steps;  // traversal events in the order the search produced them
+    bool last{false};  // set on the final batch, which fills the fields below
+    CycleWitness witness;  // cycle found, empty when acyclic
+    DetectionRecord logRecord;  // the checked graph, shared with the log writer rather than copied
+};
+
 struct EdgeRecord {
-    EdgeItem* item;
     int source;
     int target;
 };
@@ -36,10 +49,13 @@ class GraphWindow : public QWidget {
 
 public:
     explicit GraphWindow(QWidget* parent = nullptr);
+    ~GraphWindow() override;  // stops a running check, which may be suspended waiting for the animation
 
 private slots:
     void drawGraph();
+    void loadGraphFile();
     void checkForCycle();
+    void analysisBatchReady(int index);
     void onDirectionChanged();
     void nodeClicked(int index);
     void nodeMoved(int index);
@@ -52,43 +68,59 @@ private:
     void clearAnimationHighlights();
     void applyFinalCycleHighlights();
     void finalizeAnimation();
-    void handleEdgeClicked(EdgeItem* edge);
-    bool prepareAnimationSteps();
-    bool collectDirectedSteps(int vertex, QVector<bool>& visited, QVector<bool>& recursionStack);
-    bool collectUndirectedSteps();
-    EdgeItem* findEdge(int source, int target) const;
-    int findEdgeIndex(EdgeItem* edge) const;
+    void cancelAnimation();
+    void handleEdgeClicked(int index);
+    int findEdge(int source, int target) const;  // position in edges_, -1 when not drawn
+    void placeEdge(int index);  // copy the endpoint node positions into the edge layer
     void createEdge(int source, int target);
     bool edgeAlreadyExists(int source, int target) const;
+    void removeEdgeAt(int index);
+    void rebuildEdgeLookup();
     void synchronizeGraphEdges();
     void deleteVertex(int index);
     void reindexAfterVertexRemoval(int removedIndex);
-     void logCycleDetection();
+    void logCycleDetection();
+    QString logDropNotice();  // status suffix when log entries were lost since the last notice, else empty
+    void refreshStats();
     void exitDeleteMode();
     void updateResultLabel(const QString& text, bool cyclic);
     void updateStatus(const QString& text, const QString& kind = "info");
     void applyResultStyle(const QString& colorStyle);
 
     QGraphicsScene* scene_; 
-    QGraphicsView* view_;
+    GraphView* view_;  // zoomable, pannable canvas
     QSpinBox* vertexSpin_; 
     QPushButton* drawButton_;
+    QPushButton* loadButton_;
     QPushButton* checkButton_;
+    QPushButton* cancelButton_;
+    QPushButton* statsButton_;
     QRadioButton* directedRadio_; 
     QRadioButton* undirectedRadio_;
     QLabel* statusLabel_;
     QLabel* resultLabel_;
+    QProgressBar* progressBar_;
+    QLabel* statsLabel_;  // PerfCounters summary, shown while statsButton_ is checked
     Graph graph_; 
     QVector<NodeItem*> nodes_; 
-    QVector<EdgeRecord> edges_; 
+    QVector<EdgeRecord> edges_;  // drawn edges; position i is edge i of edgeLayer_
+    EdgeLayer* edgeLayer_;  // one scene item drawing every edge
+    QHash<quint64, int> edgeLookup_;  // drawn (source, target) -> position in edges_
+    QVector<QVector<int>> incidentEdges_;  // per node, positions in edges_ of the drawn edges touching it
     QPushButton* deleteEdgeButton_;
     QPushButton* deleteVertexButton_;
     NodeItem* selectedNode_{nullptr};
     int vertexCount_{0};
     bool isDirected_{false};
     QTimer* animationTimer_;
-    QVector<AnimationStep> animationSteps_;
-    int animationStepIndex_{0};
-    bool animationRunning_{false};
+    QTimer* statsTimer_;  // refreshes statsLabel_ while it is visible
+    QFutureWatcher<CycleAnalysis>* analysisWatcher_;  // background search for the current check
+    QQueue<AnimationStep> pendingSteps_;  // streamed steps not animated yet, one per timer tick
+    bool analysisDone_{false};  // the last batch of the current check has arrived
+    bool animationRunning_{false};  // a check is in progress, from the background search to the last animation step
     bool animationDetectedCycle_{false};
+    CycleWitness cycleWitness_;  // cycle reported by the graph for the current check
+    DetectionRecord pendingLogRecord_;  // log entry for the current check, queued when its animation ends
+    DetectionLog detectionLog_;  // background writer behind cycle_detection_log.txt
+    quint64 reportedLogDrops_{0};  // detectionLog_.dropped() when the status line last mentioned it
 };
@@ -5,6 +5,7 @@
 #include <QGraphicsSceneMouseEvent>
 #include <QPainter>
 #include <QPen>
+#include <QStyleOptionGraphicsItem>
 #include <QString>
 #include <QtCore/Qt>
 
@@ -13,6 +14,8 @@ constexpr qreal kNodeRadius = 28.0;
 const QColor kNodeFill = QColor(255, 105, 180);
 const QColor kNodeStroke = QColor(255, 182, 193);
 const QColor kNodeTextColor = QColor(255, 255, 255);
+constexpr qreal kLabelMinDetail = 0.45;  // below this zoom the 12 pt label is too small to read, so skip it
+constexpr qreal kOutlineMinDetail = 0.12;  // below this a node covers a few pixels; fill a square instead
 }
 
 NodeItem::NodeItem(int index, QGraphicsItem* parent)
@@ -31,6 +34,17 @@ NodeItem::NodeItem(int index, QGraphicsItem* parent)
     textFont_.setFamily("Segoe UI");
     textFont_.setBold(true);
     textFont_.setPointSize(12);
+    label_.setTextFormat(Qt::PlainText);
+    label_.setPerformanceHint(QStaticText::AggressiveCaching);
+    setIndex(index);
+}
+
+void NodeItem::setIndex(int index)
+{
+    index_ = index;
+    label_.setText(QString::number(index_));
+    label_.prepare(QTransform(), textFont_);
+    update();
 }
 
 void NodeItem::mousePressEvent(QGraphicsSceneMouseEvent* event)
@@ -64,11 +78,21 @@ QVariant NodeItem::itemChange(GraphicsItemChange change, const QVariant& value)
 
 void NodeItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
+    // The view antialiases only when zoomed in, and tiny or unreadable details are dropped here.
+    const qreal detail = option->levelOfDetailFromTransform(painter->worldTransform());
+    if (detail < kOutlineMinDetail) {
+        painter->fillRect(rect(), brush());
+        return;
+    }
+
     QGraphicsEllipseItem::paint(painter, option, widget);
-    painter->setRenderHint(QPainter::Antialiasing, true);
+    if (detail < kLabelMinDetail) {
+        return;
+    }
     painter->setPen(kNodeTextColor);
     painter->setFont(textFont_);
-    painter->drawText(boundingRect(), Qt::AlignCenter, QString::number(index_));
+    const QSizeF labelSize = label_.size();
+    painter->drawStaticText(QPointF(-labelSize.width() / 2, -labelSize.height() / 2), label_);
 }
 
 void NodeItem::highlight(const QColor& fill, const QColor& stroke)
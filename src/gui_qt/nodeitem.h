@@ -5,6 +5,7 @@
 #include <QFont>
 #include <QGraphicsEllipseItem>
 #include <QPen>
+#include <QStaticText>
 #include <QVariant>
 
 class QGraphicsSceneMouseEvent;
@@ -16,7 +17,7 @@ class NodeItem : public QObject, public QGraphicsEllipseItem {
 public:
     explicit NodeItem(int index, QGraphicsItem* parent = nullptr);
     int index() const noexcept { return index_; }
-    void setIndex(int index) noexcept { index_ = index; update(); }
+    void setIndex(int index);
     void highlight(const QColor& fill, const QColor& stroke);
     void resetAppearance();
 
@@ -35,6 +36,7 @@ private:
     int index_;
     bool dragging_{false};
     QFont textFont_;
+    QStaticText label_;  // index laid out once, redrawn without re-shaping the text
     QBrush defaultBrush_;
     QPen defaultPen_;
 };
@@ -0,0 +1,520 @@
+// neon-cycle-tests: assertion checks for the detection engine, run by ctest.
+// Each test prints the checks that failed; the exit status is non-zero when any did.
+
+#include "Logic/concurrent_disjoint_set.h"
+#include "Logic/detection_log.h"
+#include "Logic/disjoint_set.h"
+#include "Logic/graph.h"
+#include "Logic/graph_generator.h"
+#include "Logic/graph_io.h"
+#include "Logic/graph_snapshot.h"
+#include "Logic/parallel_cycle_detector.h"
+#include "Logic/perf_counters.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+int failures = 0;
+
+#define CHECK(condition) check((condition), #condition, __FILE__, __LINE__)
+
+void check(bool passed, const char* expression, const char* file, int line) {
+    if (!passed) {
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+        ++failures;
+    }
+}
+
+// A witness must be a simple closed walk over stored edges: edges[i] leaves vertices[i] and enters the next vertex.
+bool isValidWitness(const Graph& graph, const CycleWitness& witness) {
+    const std::size_t length = witness.vertices.size();
+    if (length == 0 || witness.edges.size() != length) {
+        return false;
+    }
+    if (!graph.isDirected() && length == 2) {
+        return false;  // walking one undirected edge there and back is not a cycle
+    }
+    std::set<int> seen;
+    for (std::size_t index = 0; index < length; ++index) {
+        const CycleWitness::Edge& edge = witness.edges[index];
+        if (edge.source != witness.vertices[index] || edge.target != witness.vertices[(index + 1) % length] ||
+            !graph.hasEdge(edge.source, edge.target) || !seen.insert(witness.vertices[index]).second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Reference reachability by breadth-first search over the stored edges.
+bool reaches(const Graph& graph, int from, int to) {
+    std::vector<char> visited(graph.vertexCount(), 0);
+    std::vector<int> queue{from};
+    visited[from] = 1;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        if (queue[head] == to) {
+            return true;
+        }
+        for (int neighbor : graph.neighbors(queue[head])) {
+            if (!visited[neighbor]) {
+                visited[neighbor] = 1;
+                queue.push_back(neighbor);
+            }
+        }
+    }
+    return false;
+}
+
+void testIncrementalOrdering() {
+    std::mt19937_64 random(11);
+    for (int round = 0; round < 50; ++round) {
+        const int vertexCount = 40 + round * 4;
+        Graph graph(vertexCount, true);
+        graph.setIncrementalOrdering(true);
+
+        // Edges that agree with a hidden order, inserted shuffled, so most of them force a reorder.
+        std::vector<int> rank(vertexCount);
+        std::iota(rank.begin(), rank.end(), 0);
+        std::shuffle(rank.begin(), rank.end(), random);
+        std::vector<std::pair<int, int>> forward;
+        for (int attempt = 0; attempt < vertexCount * 3; ++attempt) {
+            const int first = static_cast<int>(random() % vertexCount);
+            const int second = static_cast<int>(random() % vertexCount);
+            if (first != second) {
+                forward.emplace_back(rank[first] < rank[second] ? first : second, rank[first] < rank[second] ? second : first);
+            }
+        }
+        bool anyClosed = false;
+        for (const auto& [source, target] : forward) {
+            bool closes = true;
+            if (graph.addEdge(source, target, closes)) {
+                anyClosed = anyClosed || closes;
+            }
+        }
+        CHECK(!anyClosed);
+        CHECK(!graph.detectCycle(ExecutionPolicy::Serial));
+
+        // Removals mark the order stale; the next insertion must still classify against the real edges.
+        for (int removal = 0; removal < vertexCount / 4 && !forward.empty(); ++removal) {
+            const auto [source, target] = forward[random() % forward.size()];
+            graph.removeEdge(source, target);
+        }
+
+        // Arbitrary edges: each verdict must match reachability from the head back to the tail. An edge that
+        // closes a cycle is taken out again, so later insertions keep going through the reorder path.
+        for (int attempt = 0; attempt < vertexCount * 2; ++attempt) {
+            const int source = static_cast<int>(random() % vertexCount);
+            const int target = static_cast<int>(random() % vertexCount);
+            if (graph.hasEdge(source, target)) {
+                continue;
+            }
+            const bool expected = reaches(graph, target, source);
+            bool closes = !expected;
+            CHECK(graph.addEdge(source, target, closes));
+            CHECK(closes == expected);
+            if (expected) {
+                CHECK(graph.detectCycle(ExecutionPolicy::Serial));
+                graph.removeEdge(source, target);
+            }
+        }
+        CHECK(!graph.detectCycle(ExecutionPolicy::Serial));
+
+        Graph plain(vertexCount, true);
+        for (int vertex = 0; vertex < vertexCount; ++vertex) {
+            for (int neighbor : graph.neighbors(vertex)) {
+                plain.addEdge(vertex, neighbor);
+            }
+        }
+        CHECK(graph.detectCycle(ExecutionPolicy::Serial) == plain.detectCycle(ExecutionPolicy::Serial));
+    }
+}
+
+void testConcurrentDisjointSet() {
+    constexpr int kThreads = 4;
+    std::mt19937_64 random(23);
+    for (int round = 0; round < 20; ++round) {
+        const int size = 1000 + round * 500;
+        std::vector<std::pair<int, int>> pairs(static_cast<std::size_t>(size) * (round % 2 == 0 ? 1 : 2) / 2);
+        for (auto& [first, second] : pairs) {
+            first = static_cast<int>(random() % size);
+            second = static_cast<int>(random() % size);
+        }
+
+        DisjointSet serial(size);
+        for (const auto& [first, second] : pairs) {
+            serial.unionSets(serial.find(first), serial.find(second));
+        }
+
+        // Threads unite interleaved slices of the same pairs; every pair must still land in one set.
+        ConcurrentDisjointSet shared(size);
+        std::atomic<int> merges{0};
+        std::vector<std::thread> threads;
+        for (int thread = 0; thread < kThreads; ++thread) {
+            threads.emplace_back([&, thread] {
+                for (std::size_t index = thread; index < pairs.size(); index += kThreads) {
+                    if (shared.unite(pairs[index].first, pairs[index].second)) {
+                        merges.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        // Same partition: the roots of one map one-to-one onto the roots of the other.
+        std::unordered_map<int, int> serialFor;
+        std::unordered_map<int, int> sharedFor;
+        bool samePartition = true;
+        for (int node = 0; node < size; ++node) {
+            const int serialRoot = serial.find(node);
+            const int sharedRoot = shared.find(node);
+            samePartition = samePartition && serialFor.emplace(sharedRoot, serialRoot).first->second == serialRoot &&
+                            sharedFor.emplace(serialRoot, sharedRoot).first->second == sharedRoot;
+        }
+        CHECK(samePartition);
+        CHECK(merges.load() == size - static_cast<int>(serialFor.size()));  // exactly one successful unite per merge
+    }
+}
+
+void testParallelDetector() {
+    const ParallelCycleDetector detector(4);
+    GraphGenerator generator(31);
+    for (int round = 0; round < 12; ++round) {
+        Graph directed;
+        if (round % 2 == 0) {
+            generator.randomDag(directed, 20000, 60000);
+        } else {
+            generator.dagWithPlantedCycles(directed, 20000, 60000, 1);
+        }
+        if (round % 3 == 0) {
+            directed.freeze();
+        }
+        CHECK(detector.hasDirectedCycle(directed) == directed.detectCycle(ExecutionPolicy::Serial));
+
+        Graph undirected;
+        if (round % 2 == 0) {
+            generator.grid(undirected, 1, 20000, false);  // a path, so acyclic
+        } else {
+            generator.erdosRenyi(undirected, 20000, 15000 + round * 1000, false);
+        }
+        if (round % 3 == 0) {
+            undirected.freeze();
+        }
+        CHECK(detector.hasUndirectedCycle(undirected) == undirected.detectCycle(ExecutionPolicy::Serial));
+    }
+}
+
+// Writes text verbatim (no newline translation) to a file in the temporary directory and returns its path.
+std::filesystem::path writeTemp(const char* name, const std::string& text) {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+    std::ofstream(path, std::ios::binary) << text;
+    return path;
+}
+
+void testImporter() {
+    // Edge list with CRLF endings, both comment styles, blank lines, a malformed line, a duplicate and no final newline.
+    const std::filesystem::path edgeList = writeTemp("neon-cycle-tests-edges.txt",
+        "# SNAP-style header\r\n% another comment\r\n0 1\r\n\r\n1\t2\r\nnot an edge\r\n0 1\r\n  2 3\r\n3 0");
+    GraphImporter importer;
+    Graph graph;
+    CHECK(importer.load(edgeList, true, graph));
+    CHECK(graph.vertexCount() == 4);
+    CHECK(importer.edgesAdded() == 4);
+    CHECK(importer.linesSkipped() == 2);
+    CHECK(graph.hasEdge(1, 2) && graph.hasEdge(2, 3) && graph.hasEdge(3, 0));
+    CHECK(graph.detectCycle(ExecutionPolicy::Serial));
+
+    // DIMACS: 1-based ids, "e" and "a" edge lines, a zero id and a line of unknown kind are skipped.
+    const std::filesystem::path dimacs = writeTemp("neon-cycle-tests.dimacs",
+        "c generated for the tests\r\np edge 5 4\r\ne 1 2\r\na 2 3\r\ne 0 4\r\nx 4 5\r\ne 4 5\r\n");
+    CHECK(importer.load(dimacs, false, graph));
+    CHECK(graph.vertexCount() == 5);
+    CHECK(importer.edgesAdded() == 3);
+    CHECK(importer.linesSkipped() == 2);
+    CHECK(graph.hasEdge(1, 0) && graph.hasEdge(2, 1) && graph.hasEdge(4, 3));
+    CHECK(!graph.detectCycle(ExecutionPolicy::Serial));
+
+    const std::filesystem::path noProblem = writeTemp("neon-cycle-tests-noproblem.dimacs", "c only comments\ne 1 2\n");
+    CHECK(!importer.load(noProblem, false, graph));
+    CHECK(importer.getLastError() == GraphError::MissingProblemLine);
+
+    const std::filesystem::path twoProblems = writeTemp("neon-cycle-tests-twoproblems.dimacs", "p edge 3 1\np edge 3 1\n");
+    CHECK(!importer.load(twoProblems, false, graph));
+    CHECK(importer.getLastError() == GraphError::InvalidProblemLine);
+
+    CHECK(!importer.load(std::filesystem::temp_directory_path() / "neon-cycle-tests-missing.txt", false, graph));
+    CHECK(importer.getLastError() == GraphError::OpenFailed);
+
+    // Size limits stop the read as soon as they are crossed; a file within them loads as usual.
+    GraphImporter limited;
+    limited.setSizeLimit(4, 5);  // the duplicate counts as an edge line
+    CHECK(limited.load(edgeList, true, graph));
+    limited.setSizeLimit(4, 4);
+    CHECK(!limited.load(edgeList, true, graph));
+    CHECK(limited.getLastError() == GraphError::GraphTooLarge);
+    limited.setSizeLimit(3, 100);
+    CHECK(!limited.load(edgeList, true, graph));
+    CHECK(limited.getLastError() == GraphError::GraphTooLarge);
+    limited.setSizeLimit(4, 100);
+    CHECK(!limited.load(dimacs, false, graph));
+    CHECK(limited.getLastError() == GraphError::GraphTooLarge);
+    limited.setSizeLimit(5, 4);
+    CHECK(limited.load(dimacs, false, graph));
+    limited.setSizeLimit(5, 3);
+    CHECK(!limited.load(dimacs, false, graph));
+    CHECK(limited.getLastError() == GraphError::GraphTooLarge);
+
+    for (const auto& path : {edgeList, dimacs, noProblem, twoProblems}) {
+        std::filesystem::remove(path);
+    }
+}
+
+// Same edges, vertex for vertex: compared as sets since frozen and list graphs may order neighbors differently.
+bool sameEdges(const Graph& first, const Graph& second) {
+    if (first.vertexCount() != second.vertexCount() || first.isDirected() != second.isDirected() ||
+        first.edgeCount() != second.edgeCount()) {
+        return false;
+    }
+    for (int vertex = 0; vertex < first.vertexCount(); ++vertex) {
+        std::set<int> expected;
+        std::set<int> actual;
+        for (int neighbor : first.neighbors(vertex)) {
+            expected.insert(neighbor);
+        }
+        for (int neighbor : second.neighbors(vertex)) {
+            actual.insert(neighbor);
+        }
+        if (expected != actual) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string readFile(const std::filesystem::path& path) {
+    std::ifstream stream(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+}
+
+// Copies image with one field overwritten, saves it next to the original and reports how load() rejects it.
+template <typename Field>
+GraphError loadPatched(std::string image, std::size_t at, Field value, bool verify) {
+    std::memcpy(image.data() + at, &value, sizeof(value));
+    const std::filesystem::path path = writeTemp("neon-cycle-tests-patched.snap", image);
+    GraphSnapshot snapshot;
+    Graph graph;
+    snapshot.load(path, graph, verify);
+    const GraphError error = snapshot.getLastError();
+    std::filesystem::remove(path);
+    return error;
+}
+
+void testSnapshot() {
+    // Header field positions, from SnapshotHeader in graph_snapshot.cpp.
+    constexpr std::size_t kVertexCountAt = 20;
+    constexpr std::size_t kOffsetsAtAt = 40;
+    constexpr std::size_t kTargetsAtAt = 48;
+
+    GraphGenerator generator(43);
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "neon-cycle-tests.snap";
+    for (int round = 0; round < 4; ++round) {
+        const bool directed = round % 2 == 0;
+        Graph original;
+        generator.erdosRenyi(original, 500, 1500, directed);
+        if (round >= 2) {
+            original.freeze();
+        }
+
+        GraphSnapshot snapshot;
+        CHECK(snapshot.save(original, path));
+        CHECK(GraphSnapshot::probe(path));
+        Graph loaded;
+        CHECK(snapshot.load(path, loaded, true));
+        CHECK(loaded.isFrozen());
+        CHECK(sameEdges(original, loaded));
+        CHECK(loaded.detectCycle(ExecutionPolicy::Serial) == original.detectCycle(ExecutionPolicy::Serial));
+
+        // A failed removal leaves the adopted graph mapped; a real edit thaws it into its own lists.
+        CHECK(!loaded.removeEdge(0, 0));  // generated graphs have no self-loops
+        CHECK(loaded.isFrozen());
+        int target = 1;
+        while (loaded.hasEdge(0, target)) {
+            ++target;
+        }
+        CHECK(loaded.addEdge(0, target));
+        CHECK(!loaded.isFrozen());
+        CHECK(loaded.edgeCount() == original.edgeCount() + 1);
+    }
+
+    // Reference image of a small graph with a known layout: 4 vertices, 4 edges.
+    Graph small(4, true);
+    small.addEdge(0, 1);
+    small.addEdge(1, 2);
+    small.addEdge(2, 3);
+    small.addEdge(3, 1);
+    GraphSnapshot snapshot;
+    CHECK(snapshot.save(small, path));
+    const std::string image = readFile(path);
+    std::uint64_t offsetsAt = 0;
+    std::uint64_t targetsAt = 0;
+    std::memcpy(&offsetsAt, image.data() + kOffsetsAtAt, sizeof(offsetsAt));
+    std::memcpy(&targetsAt, image.data() + kTargetsAtAt, sizeof(targetsAt));
+    CHECK(image.size() == targetsAt + 4 * sizeof(int));
+
+    // Array contents are checked only when verifying; the header and bounds checks run on every load.
+    CHECK(loadPatched(image, targetsAt, 4, true) == GraphError::CorruptSnapshot);  // target out of range
+    CHECK(loadPatched(image, targetsAt, -1, true) == GraphError::CorruptSnapshot);
+    CHECK(loadPatched(image, offsetsAt + 2 * sizeof(std::int64_t), std::int64_t(0), true) ==
+          GraphError::CorruptSnapshot);  // offsets decrease
+    CHECK(loadPatched(image, kVertexCountAt, std::int32_t(1) << 28, false) == GraphError::CorruptSnapshot);
+    CHECK(loadPatched(image, kVertexCountAt, std::int32_t(-1), false) == GraphError::CorruptSnapshot);
+    CHECK(loadPatched(image, kTargetsAtAt, targetsAt + 8, false) == GraphError::CorruptSnapshot);
+    CHECK(loadPatched(image, 0, 'X', false) == GraphError::NotASnapshot);
+
+    // A valid but different target passes the structural checks and is caught only by the checksum.
+    CHECK(loadPatched(image, targetsAt, 3, false) == GraphError::None);
+    CHECK(loadPatched(image, targetsAt, 3, true) == GraphError::ChecksumMismatch);
+
+    const std::filesystem::path truncated = writeTemp("neon-cycle-tests-truncated.snap", image.substr(0, image.size() - 4));
+    Graph graph;
+    CHECK(!snapshot.load(truncated, graph));
+    CHECK(snapshot.getLastError() == GraphError::CorruptSnapshot);
+    CHECK(graph.vertexCount() == 0);  // a rejected file leaves the graph alone
+
+    std::filesystem::remove(truncated);
+    std::filesystem::remove(path);
+}
+
+void testDetectionLog() {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "neon-cycle-tests-log.txt";
+    std::filesystem::remove(path);
+
+    auto graph = std::make_shared<Graph>(5, false);
+    graph->addEdge(4, 0);
+    graph->addEdge(3, 1);
+    graph->components();  // memoized before submit(), as the GUI does
+    const auto record = [&graph] {
+        DetectionRecord entry;
+        entry.vertexCount = graph->vertexCount();
+        entry.graph = graph;
+        return entry;
+    };
+
+    DetectionLog::Options options;
+    options.path = path;
+    options.maxQueuedBytes = 1;  // any second record is over budget
+    options.flushInterval = std::chrono::hours(1);  // nothing is written until the destructor drains the queue
+    {
+        DetectionLog log(options);
+        CHECK(log.submit(record()));  // an empty queue always takes one record
+        CHECK(!log.submit(record()));
+        CHECK(log.dropped() == 1);
+    }
+
+    // Sets follow their smallest vertex: {0, 4}, {1, 3}, {2}.
+    const std::string text = readFile(path);
+    CHECK(text.find("  Set 1: 0, 4\n  Set 2: 1, 3\n  Set 3: 2\n") != std::string::npos);
+    const std::size_t entry = text.find("Vertex count: 5");
+    CHECK(entry != std::string::npos && entry == text.rfind("Vertex count: 5"));  // exactly one entry
+    std::filesystem::remove(path);
+}
+
+void testNodePoolRelease() {
+    // Clearing or reconfiguring a large list graph hands most pool blocks back instead of keeping its peak.
+    PerfCounters& counters = PerfCounters::instance();
+    const std::int64_t before = counters.adjacencyBytes();
+    GraphGenerator generator(53);
+    Graph graph;
+    generator.chain(graph, 300000, false);
+    const std::int64_t loaded = counters.adjacencyBytes() - before;
+    graph.clearEdges();
+    CHECK(counters.adjacencyBytes() - before < loaded / 4);
+
+    generator.chain(graph, 300000, false);
+    graph.configure(10, true);
+    CHECK(counters.adjacencyBytes() - before < loaded / 4);
+}
+
+void testWitness() {
+    Graph chain(4, true);
+    chain.addEdge(0, 1);
+    chain.addEdge(1, 2);
+    chain.addEdge(2, 3);
+    CHECK(chain.cycleWitness().isEmpty());
+    chain.addEdge(3, 1);
+    CHECK(isValidWitness(chain, chain.cycleWitness()));
+    CHECK(chain.cycleWitness().vertices.size() == 3);
+
+    Graph loop(2, true);
+    loop.addEdge(1, 1);
+    CHECK(isValidWitness(loop, loop.cycleWitness()));
+
+    Graph triangle(5, false);
+    triangle.addEdge(0, 1);
+    triangle.addEdge(1, 2);
+    triangle.addEdge(3, 4);
+    CHECK(triangle.cycleWitness().isEmpty());
+    triangle.addEdge(2, 0);
+    CHECK(isValidWitness(triangle, triangle.cycleWitness()));
+
+    // Frozen graphs walk the CSR arrays instead of the lists; the witness must not change meaning.
+    GraphGenerator generator(7);
+    for (int round = 0; round < 20; ++round) {
+        Graph directed;
+        generator.dagWithPlantedCycles(directed, 2000, 6000, 1 + round % 3);
+        if (round % 2 == 1) {
+            directed.freeze();
+        }
+        CHECK(directed.detectCycle(ExecutionPolicy::Serial));
+        CHECK(isValidWitness(directed, directed.cycleWitness()));
+
+        Graph undirected;
+        generator.erdosRenyi(undirected, 2000, 1990 + round, false);
+        if (round % 2 == 1) {
+            undirected.freeze();
+        }
+        const CycleWitness& witness = undirected.cycleWitness();
+        CHECK(witness.isEmpty() != undirected.detectCycle(ExecutionPolicy::Serial));
+        CHECK(witness.isEmpty() || isValidWitness(undirected, witness));
+    }
+
+    Graph dag;
+    generator.randomDag(dag, 2000, 8000);
+    CHECK(!dag.detectCycle(ExecutionPolicy::Serial));
+    CHECK(dag.cycleWitness().isEmpty());
+}
+}
+
+int main() {
+    testWitness();
+    testIncrementalOrdering();
+    testConcurrentDisjointSet();
+    testParallelDetector();
+    testImporter();
+    testSnapshot();
+    testDetectionLog();
+    testNodePoolRelease();
+
+    if (failures > 0) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::puts("all checks passed");
+    return 0;
+}